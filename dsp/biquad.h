@@ -0,0 +1,213 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Cascade of second order sections (transposed direct form II), for high
+// order IIR designs. Shapes from Robert Bristow-Johnson's audio EQ cookbook.
+
+#ifndef STMLIB_DSP_BIQUAD_H_
+#define STMLIB_DSP_BIQUAD_H_
+
+#include "stmlib/stmlib.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace stmlib {
+
+template<size_t num_sections>
+class BiquadCascade {
+ public:
+  BiquadCascade() { }
+  ~BiquadCascade() { }
+
+  void Init() {
+    for (size_t i = 0; i < num_sections; ++i) {
+      set_coefficients(i, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+    }
+    Reset();
+  }
+
+  void Reset() {
+    std::fill(&s1_[0], &s1_[num_sections], 0.0f);
+    std::fill(&s2_[0], &s2_[num_sections], 0.0f);
+  }
+
+  // Coefficients normalized by a0, for designs computed elsewhere.
+  inline void set_coefficients(
+      size_t section,
+      float b0, float b1, float b2,
+      float a1, float a2) {
+    b0_[section] = b0;
+    b1_[section] = b1;
+    b2_[section] = b2;
+    a1_[section] = a1;
+    a2_[section] = a2;
+  }
+
+  // In all the following, f is the frequency normalized by the sample rate.
+  inline void set_low_pass(size_t section, float f, float q) {
+    Prewarp w(f, q);
+    float b = (1.0f - w.cos) * 0.5f;
+    Set(section, b, 2.0f * b, b, w);
+  }
+
+  inline void set_high_pass(size_t section, float f, float q) {
+    Prewarp w(f, q);
+    float b = (1.0f + w.cos) * 0.5f;
+    Set(section, b, -2.0f * b, b, w);
+  }
+
+  // Constant 0dB peak gain.
+  inline void set_band_pass(size_t section, float f, float q) {
+    Prewarp w(f, q);
+    Set(section, w.alpha, 0.0f, -w.alpha, w);
+  }
+
+  inline void set_notch(size_t section, float f, float q) {
+    Prewarp w(f, q);
+    Set(section, 1.0f, -2.0f * w.cos, 1.0f, w);
+  }
+
+  inline void set_all_pass(size_t section, float f, float q) {
+    Prewarp w(f, q);
+    Set(section, 1.0f - w.alpha, -2.0f * w.cos, 1.0f + w.alpha, w);
+  }
+
+  inline void set_peaking(size_t section, float f, float q, float gain_db) {
+    Prewarp w(f, q);
+    float a = powf(10.0f, gain_db * (1.0f / 40.0f));
+    float a0 = 1.0f + w.alpha / a;
+    float a0_inv = 1.0f / a0;
+    set_coefficients(
+        section,
+        (1.0f + w.alpha * a) * a0_inv,
+        -2.0f * w.cos * a0_inv,
+        (1.0f - w.alpha * a) * a0_inv,
+        -2.0f * w.cos * a0_inv,
+        (1.0f - w.alpha / a) * a0_inv);
+  }
+
+  inline void set_low_shelf(size_t section, float f, float q, float gain_db) {
+    Prewarp w(f, q);
+    float a = powf(10.0f, gain_db * (1.0f / 40.0f));
+    float k = 2.0f * sqrtf(a) * w.alpha;
+    float a0_inv = 1.0f / ((a + 1.0f) + (a - 1.0f) * w.cos + k);
+    set_coefficients(
+        section,
+        a * ((a + 1.0f) - (a - 1.0f) * w.cos + k) * a0_inv,
+        2.0f * a * ((a - 1.0f) - (a + 1.0f) * w.cos) * a0_inv,
+        a * ((a + 1.0f) - (a - 1.0f) * w.cos - k) * a0_inv,
+        -2.0f * ((a - 1.0f) + (a + 1.0f) * w.cos) * a0_inv,
+        ((a + 1.0f) + (a - 1.0f) * w.cos - k) * a0_inv);
+  }
+
+  inline void set_high_shelf(size_t section, float f, float q, float gain_db) {
+    Prewarp w(f, q);
+    float a = powf(10.0f, gain_db * (1.0f / 40.0f));
+    float k = 2.0f * sqrtf(a) * w.alpha;
+    float a0_inv = 1.0f / ((a + 1.0f) - (a - 1.0f) * w.cos + k);
+    set_coefficients(
+        section,
+        a * ((a + 1.0f) + (a - 1.0f) * w.cos + k) * a0_inv,
+        -2.0f * a * ((a - 1.0f) + (a + 1.0f) * w.cos) * a0_inv,
+        a * ((a + 1.0f) + (a - 1.0f) * w.cos - k) * a0_inv,
+        2.0f * ((a - 1.0f) - (a + 1.0f) * w.cos) * a0_inv,
+        ((a + 1.0f) - (a - 1.0f) * w.cos - k) * a0_inv);
+  }
+
+  inline float Process(float in) {
+    for (size_t i = 0; i < num_sections; ++i) {
+      float out = b0_[i] * in + s1_[i];
+      s1_[i] = b1_[i] * in - a1_[i] * out + s2_[i];
+      s2_[i] = b2_[i] * in - a2_[i] * out;
+      in = out;
+    }
+    return in;
+  }
+
+  // The state of all sections is copied to local variables for the duration
+  // of the block. Can be used in place.
+  inline void Process(const float* in, float* out, size_t size) {
+    float s1[num_sections];
+    float s2[num_sections];
+    std::copy(&s1_[0], &s1_[num_sections], &s1[0]);
+    std::copy(&s2_[0], &s2_[num_sections], &s2[0]);
+
+    while (size--) {
+      float x = *in++;
+      for (size_t i = 0; i < num_sections; ++i) {
+        float y = b0_[i] * x + s1[i];
+        s1[i] = b1_[i] * x - a1_[i] * y + s2[i];
+        s2[i] = b2_[i] * x - a2_[i] * y;
+        x = y;
+      }
+      *out++ = x;
+    }
+
+    std::copy(&s1[0], &s1[num_sections], &s1_[0]);
+    std::copy(&s2[0], &s2[num_sections], &s2_[0]);
+  }
+
+ private:
+  struct Prewarp {
+    Prewarp(float f, float q) {
+      f = f < 0.497f ? f : 0.497f;
+      float omega = 2.0f * float(M_PI) * f;
+      cos = cosf(omega);
+      alpha = sinf(omega) / (2.0f * q);
+    }
+    float cos;
+    float alpha;
+  };
+
+  // Normalizes and stores coefficients for shapes sharing the same
+  // denominator 1 + alpha, -2 cos, 1 - alpha.
+  inline void Set(size_t section, float b0, float b1, float b2, Prewarp w) {
+    float a0_inv = 1.0f / (1.0f + w.alpha);
+    set_coefficients(
+        section,
+        b0 * a0_inv,
+        b1 * a0_inv,
+        b2 * a0_inv,
+        -2.0f * w.cos * a0_inv,
+        (1.0f - w.alpha) * a0_inv);
+  }
+
+  float b0_[num_sections];
+  float b1_[num_sections];
+  float b2_[num_sections];
+  float a1_[num_sections];
+  float a2_[num_sections];
+
+  float s1_[num_sections];
+  float s2_[num_sections];
+
+  DISALLOW_COPY_AND_ASSIGN(BiquadCascade);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_BIQUAD_H_
@@ -31,14 +31,132 @@
 
 #include "stmlib/stmlib.h"
 #include "stmlib/dsp/dsp.h"
+#include "stmlib/utils/buffer_allocator.h"
 
 #include <algorithm>
 
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif  // __SSE__
+
 namespace stmlib {
 
-template<typename T, size_t max_delay>
+enum DelayLineInterpolation {
+  DELAY_LINE_INTERPOLATION_LINEAR,
+  DELAY_LINE_INTERPOLATION_HERMITE,
+  DELAY_LINE_INTERPOLATION_ALLPASS
+};
+
+// Storage codecs for DelayLine. Samples are compressed when written and
+// decompressed when read, so that the line can store a narrower type than
+// the one it is read and written with.
+template<typename T>
+struct IdentityCodec {
+  typedef T Storage;
+
+  static inline T Decompress(Storage value) {
+    return value;
+  }
+
+  static inline Storage Compress(T value) {
+    return value;
+  }
+};
+
+// Q15, for a full scale of +/-2^headroom_bits. Values are rounded to the
+// nearest step, and clipped beyond full scale. The gain is restricted to powers
+// of two, since a float cannot be a template argument: this keeps the scaling
+// exact, and folded into a constant. Other gains are applied by the caller,
+// before writing and after reading.
+template<int32_t headroom_bits = 0>
+struct Q15Codec {
+  typedef int16_t Storage;
+
+  static inline float Decompress(Storage value) {
+    return static_cast<float>(value) * (
+        static_cast<float>(1 << headroom_bits) / 32768.0f);
+  }
+
+  static inline Storage Compress(float value) {
+    float x = value * (32768.0f / static_cast<float>(1 << headroom_bits));
+    // Clipped before the conversion, which is undefined out of the range of
+    // int32_t (NaN goes to -32768).
+    x = x > -32768.0f ? x : -32768.0f;
+    x = x < 32767.0f ? x : 32767.0f;
+    return static_cast<Storage>(x + (x >= 0.0f ? 0.5f : -0.5f));
+  }
+};
+
+// IEEE 754 half precision: 11 bits of precision over a 80 dB range, plus
+// subnormals. Native conversion instructions are used when the target has
+// them. Values beyond +/-65504 are clipped.
+struct HalfFloatCodec {
+#ifdef __ARM_FP16_FORMAT_IEEE
+  typedef __fp16 Storage;
+
+  static inline float Decompress(Storage value) {
+    return value;
+  }
+
+  static inline Storage Compress(float value) {
+    // Clipped before the conversion, which would otherwise overflow to inf.
+    value = value > -65504.0f ? value : -65504.0f;
+    value = value < 65504.0f ? value : 65504.0f;
+    return value;
+  }
+#else
+  typedef uint16_t Storage;
+
+  static inline float Decompress(Storage value) {
+    union {
+      float f;
+      uint32_t i;
+    } u;
+    uint32_t exponent = value & 0x7c00;
+    u.i = static_cast<uint32_t>(value & 0x7fff) << 13;
+    if (exponent == 0x7c00) {
+      u.i += (255 - 31) << 23;
+    } else if (exponent == 0) {
+      // Subnormal: let the FPU normalize it.
+      u.i += 113 << 23;
+      u.f -= 6.10351562e-05f;
+    } else {
+      u.i += (127 - 15) << 23;
+    }
+    u.i |= static_cast<uint32_t>(value & 0x8000) << 16;
+    return u.f;
+  }
+
+  static inline Storage Compress(float value) {
+    union {
+      float f;
+      uint32_t i;
+    } u;
+    u.f = value;
+    uint32_t sign = (u.i >> 16) & 0x8000;
+    u.i &= 0x7fffffff;
+    uint32_t h;
+    if (u.i >= 0x477ff000) {
+      h = 0x7bff;
+    } else if (u.i < 0x38800000) {
+      // Subnormal: adding 0.5 aligns the mantissa bits so that they are
+      // rounded by the FPU.
+      u.f += 0.5f;
+      h = u.i - 0x3f000000;
+    } else {
+      // Round to nearest even.
+      h = (u.i - ((127 - 15) << 23) + 0xfff + ((u.i >> 13) & 1)) >> 13;
+    }
+    return static_cast<Storage>(h | sign);
+  }
+#endif  // __ARM_FP16_FORMAT_IEEE
+};
+
+template<typename T, size_t max_delay, typename Codec = IdentityCodec<T> >
 class DelayLine {
  public:
+  typedef typename Codec::Storage Storage;
+
   DelayLine() { }
   ~DelayLine() { }
   
@@ -47,7 +165,7 @@ class DelayLine {
   }
 
   void Reset() {
-    std::fill(&line_[0], &line_[max_delay], T(0));
+    std::fill(&line_[0], &line_[max_delay], Codec::Compress(T(0)));
     delay_ = 1;
     write_ptr_ = 0;
   }
@@ -57,12 +175,12 @@ class DelayLine {
   }
 
   inline void Write(const T sample) {
-    line_[write_ptr_] = sample;
+    line_[write_ptr_] = Codec::Compress(sample);
     write_ptr_ = (write_ptr_ - 1 + max_delay) % max_delay;
   }
   
   inline const T Allpass(const T sample, size_t delay, const T coefficient) {
-    T read = line_[(write_ptr_ + delay) % max_delay];
+    T read = Codec::Decompress(line_[(write_ptr_ + delay) % max_delay]);
     T write = sample + coefficient * read;
     Write(write);
     return -write * coefficient + read;
@@ -74,27 +192,29 @@ class DelayLine {
   }
   
   inline const T Read() const {
-    return line_[(write_ptr_ + delay_) % max_delay];
+    return Codec::Decompress(line_[(write_ptr_ + delay_) % max_delay]);
   }
   
   inline const T Read(size_t delay) const {
-    return line_[(write_ptr_ + delay) % max_delay];
+    return Codec::Decompress(line_[(write_ptr_ + delay) % max_delay]);
   }
 
   inline const T Read(float delay) const {
     MAKE_INTEGRAL_FRACTIONAL(delay)
-    const T a = line_[(write_ptr_ + delay_integral) % max_delay];
-    const T b = line_[(write_ptr_ + delay_integral + 1) % max_delay];
+    const T a = Codec::Decompress(
+        line_[(write_ptr_ + delay_integral) % max_delay]);
+    const T b = Codec::Decompress(
+        line_[(write_ptr_ + delay_integral + 1) % max_delay]);
     return a + (b - a) * delay_fractional;
   }
   
   inline const T ReadHermite(float delay) const {
     MAKE_INTEGRAL_FRACTIONAL(delay)
     int32_t t = (write_ptr_ + delay_integral + max_delay);
-    const T xm1 = line_[(t - 1) % max_delay];
-    const T x0 = line_[(t) % max_delay];
-    const T x1 = line_[(t + 1) % max_delay];
-    const T x2 = line_[(t + 2) % max_delay];
+    const T xm1 = Codec::Decompress(line_[(t - 1) % max_delay]);
+    const T x0 = Codec::Decompress(line_[(t) % max_delay]);
+    const T x1 = Codec::Decompress(line_[(t + 1) % max_delay]);
+    const T x2 = Codec::Decompress(line_[(t + 2) % max_delay]);
     const float c = (x1 - xm1) * 0.5f;
     const float v = x0 - x1;
     const float w = c + v;
@@ -107,11 +227,381 @@ class DelayLine {
  private:
   size_t write_ptr_;
   size_t delay_;
-  T line_[max_delay];
+  Storage line_[max_delay];
   
   DISALLOW_COPY_AND_ASSIGN(DelayLine);
 };
 
+// Same interface, with a power of two size so that all indices are wrapped
+// with a mask. Samples are stored in chronological order, which allows blocks
+// to be written and read with plain copies. The first samples of the line are
+// mirrored past its end, so that the 4 points needed by an interpolated read
+// are always contiguous.
+template<typename T, size_t max_delay>
+class PowerOfTwoDelayLine {
+ public:
+  PowerOfTwoDelayLine() { }
+  ~PowerOfTwoDelayLine() { }
+
+  // A delayed window of the line, made of at most two contiguous segments.
+  struct Window {
+    const T* first;
+    size_t first_size;
+    const T* second;
+    size_t second_size;
+  };
+
+  void Init() {
+    Reset();
+  }
+
+  void Reset() {
+    std::fill(&line_[0], &line_[max_delay + GUARD], T(0));
+    delay_ = 1;
+    write_ptr_ = 0;
+  }
+
+  inline void set_delay(size_t delay) {
+    delay_ = delay;
+  }
+
+  inline void Write(const T sample) {
+    line_[write_ptr_] = sample;
+    if (write_ptr_ < GUARD) {
+      line_[max_delay + write_ptr_] = sample;
+    }
+    write_ptr_ = (write_ptr_ + 1) & MASK;
+  }
+
+  // size must not exceed max_delay.
+  inline void Write(const T* in, size_t size) {
+    size_t first_size = std::min(size, max_delay - write_ptr_);
+    std::copy(&in[0], &in[first_size], &line_[write_ptr_]);
+    std::copy(&in[first_size], &in[size], &line_[0]);
+    std::copy(&line_[0], &line_[GUARD], &line_[max_delay]);
+    write_ptr_ = (write_ptr_ + size) & MASK;
+  }
+
+  inline const T Allpass(const T sample, size_t delay, const T coefficient) {
+    T read = line_[(write_ptr_ - delay) & MASK];
+    T write = sample + coefficient * read;
+    Write(write);
+    return -write * coefficient + read;
+  }
+
+  inline const T WriteRead(const T sample, float delay) {
+    Write(sample);
+    return Read(delay);
+  }
+
+  inline const T Read() const {
+    return line_[(write_ptr_ - delay_) & MASK];
+  }
+
+  inline const T Read(size_t delay) const {
+    return line_[(write_ptr_ - delay) & MASK];
+  }
+
+  // Same as calling Read(delay) then Write() for each sample of a block of
+  // the given size - the block is read before being written. Requires
+  // size <= delay <= max_delay.
+  inline void Read(size_t delay, T* out, size_t size) const {
+    Window w = window(delay, size);
+    out = std::copy(&w.first[0], &w.first[w.first_size], out);
+    std::copy(&w.second[0], &w.second[w.second_size], out);
+  }
+
+  inline const Window window(size_t delay, size_t size) const {
+    size_t start = (write_ptr_ - delay) & MASK;
+    Window w;
+    w.first = &line_[start];
+    w.first_size = std::min(size, max_delay - start);
+    w.second = &line_[0];
+    w.second_size = size - w.first_size;
+    return w;
+  }
+
+  inline const T Read(float delay) const {
+    MAKE_INTEGRAL_FRACTIONAL(delay)
+    const T a = line_[(write_ptr_ - delay_integral) & MASK];
+    const T b = line_[(write_ptr_ - delay_integral - 1) & MASK];
+    return a + (b - a) * delay_fractional;
+  }
+
+  inline const T ReadHermite(float delay) const {
+    MAKE_INTEGRAL_FRACTIONAL(delay)
+    size_t t = write_ptr_ - delay_integral;
+    const T xm1 = line_[(t + 1) & MASK];
+    const T x0 = line_[(t) & MASK];
+    const T x1 = line_[(t - 1) & MASK];
+    const T x2 = line_[(t - 2) & MASK];
+    const float c = (x1 - xm1) * 0.5f;
+    const float v = x0 - x1;
+    const float w = c + v;
+    const float a = w + v + (x2 - x0) * 0.5f;
+    const float b_neg = w + a;
+    const float f = delay_fractional;
+    return (((a * f) - b_neg) * f + c) * f + x0;
+  }
+
+  // Reads num_taps modulated taps for each sample of the block that has just
+  // been written - the same as calling Write() then Read(float) or
+  // ReadHermite() for each tap and sample. delays and out are interleaved:
+  // delays[i * num_taps + j] is the delay of tap j at sample i, relative to
+  // this sample. Delays must be at least 1 (2 for Hermite and allpass
+  // interpolation) and less than max_delay - size - 2. Allpass interpolation is
+  // recursive: state holds the previous output of each tap, and is not used
+  // by the other modes.
+  template<DelayLineInterpolation interpolation>
+  inline void ReadTaps(
+      const float* delays,
+      float* out,
+      size_t num_taps,
+      size_t size,
+      float* state = NULL) const {
+    size_t base = write_ptr_ - size - 1;
+    while (size--) {
+      ++base;
+      size_t j = 0;
+      if (interpolation != DELAY_LINE_INTERPOLATION_ALLPASS) {
+        j = InterpolateTaps<interpolation>(
+            &line_[0], base, delays, out, num_taps);
+      }
+      for (; j < num_taps; ++j) {
+        float delay = delays[j];
+        MAKE_INTEGRAL_FRACTIONAL(delay)
+        // Points x2, x1, x0 and xm1, from the oldest.
+        const T* x = &line_[(base - delay_integral - 1) & MASK];
+        if (interpolation == DELAY_LINE_INTERPOLATION_LINEAR) {
+          out[j] = x[2] + (x[1] - x[2]) * delay_fractional;
+        } else if (interpolation == DELAY_LINE_INTERPOLATION_HERMITE) {
+          const T xm1 = x[3];
+          const T x0 = x[2];
+          const T x1 = x[1];
+          const T x2 = x[0];
+          const float c = (x1 - xm1) * 0.5f;
+          const float v = x0 - x1;
+          const float w = c + v;
+          const float a = w + v + (x2 - x0) * 0.5f;
+          const float b_neg = w + a;
+          const float f = delay_fractional;
+          out[j] = (((a * f) - b_neg) * f + c) * f + x0;
+        } else {
+          // First order allpass, with the fractional part kept in [0.5, 1.5)
+          // where its group delay is the flattest.
+          const T* u = &x[2];
+          if (delay_fractional < 0.5f) {
+            delay_fractional += 1.0f;
+            ++u;
+          }
+          const float eta = (1.0f - delay_fractional) /
+              (1.0f + delay_fractional);
+          float y = u[-1] + eta * (u[0] - state[j]);
+          state[j] = y;
+          out[j] = y;
+        }
+      }
+      delays += num_taps;
+      out += num_taps;
+    }
+  }
+
+ private:
+#ifdef __SSE__
+  // With the guard band, the 4 points of a tap are a single load. Taps are
+  // processed 4 at a time, with a transposition to get one vector per point.
+  // Returns the number of taps read.
+  template<DelayLineInterpolation interpolation>
+  inline size_t InterpolateTaps(
+      const float* line,
+      size_t base,
+      const float* delays,
+      float* out,
+      size_t num_taps) const {
+    num_taps &= ~size_t(3);
+    for (size_t j = 0; j < num_taps; j += 4) {
+      const int32_t i0 = static_cast<int32_t>(delays[j]);
+      const int32_t i1 = static_cast<int32_t>(delays[j + 1]);
+      const int32_t i2 = static_cast<int32_t>(delays[j + 2]);
+      const int32_t i3 = static_cast<int32_t>(delays[j + 3]);
+      __m128 x2 = _mm_loadu_ps(&line[(base - i0 - 1) & MASK]);
+      __m128 x1 = _mm_loadu_ps(&line[(base - i1 - 1) & MASK]);
+      __m128 x0 = _mm_loadu_ps(&line[(base - i2 - 1) & MASK]);
+      __m128 xm1 = _mm_loadu_ps(&line[(base - i3 - 1) & MASK]);
+      _MM_TRANSPOSE4_PS(x2, x1, x0, xm1);
+      const __m128 f = _mm_sub_ps(
+          _mm_loadu_ps(&delays[j]),
+          _mm_setr_ps(
+              static_cast<float>(i0),
+              static_cast<float>(i1),
+              static_cast<float>(i2),
+              static_cast<float>(i3)));
+      if (interpolation == DELAY_LINE_INTERPOLATION_LINEAR) {
+        _mm_storeu_ps(
+            &out[j],
+            _mm_add_ps(x0, _mm_mul_ps(_mm_sub_ps(x1, x0), f)));
+      } else {
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 c = _mm_mul_ps(_mm_sub_ps(x1, xm1), half);
+        const __m128 v = _mm_sub_ps(x0, x1);
+        const __m128 w = _mm_add_ps(c, v);
+        const __m128 a = _mm_add_ps(
+            _mm_add_ps(w, v),
+            _mm_mul_ps(_mm_sub_ps(x2, x0), half));
+        const __m128 b_neg = _mm_add_ps(w, a);
+        __m128 y = _mm_sub_ps(_mm_mul_ps(a, f), b_neg);
+        y = _mm_add_ps(_mm_mul_ps(y, f), c);
+        y = _mm_add_ps(_mm_mul_ps(y, f), x0);
+        _mm_storeu_ps(&out[j], y);
+      }
+    }
+    return num_taps;
+  }
+#endif  // __SSE__
+
+  // Other sample types are only read by the scalar loop.
+  template<DelayLineInterpolation interpolation, typename U>
+  inline size_t InterpolateTaps(
+      const U*, size_t, const float*, float*, size_t) const {
+    return 0;
+  }
+
+  enum {
+    MASK = max_delay - 1,
+    GUARD = 3
+  };
+  STATIC_ASSERT((max_delay & MASK) == 0, max_delay_must_be_a_power_of_two);
+
+  size_t write_ptr_;
+  size_t delay_;
+  T line_[max_delay + GUARD];
+
+  DISALLOW_COPY_AND_ASSIGN(PowerOfTwoDelayLine);
+};
+
+// Same interface as DelayLine, with a size chosen at run time and storage
+// taken from a BufferAllocator. Effects used in different modes can thus
+// share the same memory region: Free() the allocator and Init() the lines
+// of the new mode. Indices are wrapped with a comparison rather than a
+// modulo, so delays must be in [0, max_delay) - the range in which DelayLine
+// is valid too, and in which both lines return the same values.
+template<typename T, typename Codec = IdentityCodec<T> >
+class DynamicDelayLine {
+ public:
+  typedef typename Codec::Storage Storage;
+
+  DynamicDelayLine() { }
+  ~DynamicDelayLine() { }
+
+  // BufferAllocator does not align its allocations, so the size of the line
+  // is rounded up to a multiple of 4 bytes - otherwise a Q15 line with an odd
+  // max_delay would misalign the float buffers allocated after it.
+  bool Init(BufferAllocator* allocator, size_t max_delay) {
+    if (!max_delay) {
+      return false;
+    }
+    size_t size = max_delay;
+    while ((size * sizeof(Storage)) & 3) {
+      ++size;
+    }
+    Storage* line = allocator->Allocate<Storage>(size);
+    return line && Init(line, max_delay);
+  }
+
+  // The line must not be used if Init fails.
+  bool Init(Storage* line, size_t max_delay) {
+    if (!line || !max_delay) {
+      return false;
+    }
+    line_ = line;
+    max_delay_ = max_delay;
+    Reset();
+    return true;
+  }
+
+  void Reset() {
+    std::fill(&line_[0], &line_[max_delay_], Codec::Compress(T(0)));
+    delay_ = 1;
+    write_ptr_ = 0;
+  }
+
+  inline size_t max_delay() const {
+    return max_delay_;
+  }
+
+  inline void set_delay(size_t delay) {
+    delay_ = delay;
+  }
+
+  inline void Write(const T sample) {
+    line_[write_ptr_] = Codec::Compress(sample);
+    write_ptr_ = (write_ptr_ ? write_ptr_ : max_delay_) - 1;
+  }
+
+  inline const T Allpass(const T sample, size_t delay, const T coefficient) {
+    T read = Codec::Decompress(line_[Wrap(write_ptr_ + delay)]);
+    T write = sample + coefficient * read;
+    Write(write);
+    return -write * coefficient + read;
+  }
+
+  inline const T WriteRead(const T sample, float delay) {
+    Write(sample);
+    return Read(delay);
+  }
+
+  inline const T Read() const {
+    return Codec::Decompress(line_[Wrap(write_ptr_ + delay_)]);
+  }
+
+  inline const T Read(size_t delay) const {
+    return Codec::Decompress(line_[Wrap(write_ptr_ + delay)]);
+  }
+
+  inline const T Read(float delay) const {
+    MAKE_INTEGRAL_FRACTIONAL(delay)
+    size_t t = write_ptr_ + delay_integral;
+    const T a = Codec::Decompress(line_[Wrap(t)]);
+    const T b = Codec::Decompress(line_[Wrap(t + 1)]);
+    return a + (b - a) * delay_fractional;
+  }
+
+  inline const T ReadHermite(float delay) const {
+    MAKE_INTEGRAL_FRACTIONAL(delay)
+    size_t t = write_ptr_ + delay_integral;
+    const T xm1 = Codec::Decompress(line_[Wrap(t + max_delay_ - 1)]);
+    const T x0 = Codec::Decompress(line_[Wrap(t)]);
+    const T x1 = Codec::Decompress(line_[Wrap(t + 1)]);
+    const T x2 = Codec::Decompress(line_[Wrap(t + 2)]);
+    const float c = (x1 - xm1) * 0.5f;
+    const float v = x0 - x1;
+    const float w = c + v;
+    const float a = w + v + (x2 - x0) * 0.5f;
+    const float b_neg = w + a;
+    const float f = delay_fractional;
+    return (((a * f) - b_neg) * f + c) * f + x0;
+  }
+
+ private:
+  // i must be in [0, 3 * max_delay_).
+  inline size_t Wrap(size_t i) const {
+    if (i >= max_delay_) {
+      i -= max_delay_;
+      if (i >= max_delay_) {
+        i -= max_delay_;
+      }
+    }
+    return i;
+  }
+
+  size_t write_ptr_;
+  size_t delay_;
+  size_t max_delay_;
+  Storage* line_;
+
+  DISALLOW_COPY_AND_ASSIGN(DynamicDelayLine);
+};
+
 }  // namespace stmlib
 
 #endif  // STMLIB_DSP_DELAY_LINE_H_
@@ -0,0 +1,86 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Scoped flush-to-zero of denormal numbers.
+//
+// When the input of a recursive filter (Svf, OnePole, DCBlocker, delay line
+// feedback...) goes silent, its state decays into denormals, which are
+// processed in microcode on x86 and can make silent tails more than 10x
+// slower to render. Create a ScopedFlushDenormals at the top of the render
+// function to set the FTZ/DAZ (x86) or FZ (aarch64) flags for its duration.
+// The Cortex-M FPU handles denormals without penalty, so on the embedded
+// targets this is an empty object.
+
+#ifndef STMLIB_DSP_DENORMALS_H_
+#define STMLIB_DSP_DENORMALS_H_
+
+#include "stmlib/stmlib.h"
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif  // __SSE__
+
+namespace stmlib {
+
+class ScopedFlushDenormals {
+ public:
+  ScopedFlushDenormals() {
+#if defined(__SSE__)
+    // Flush-to-zero (bit 15) and denormals-are-zero (bit 6).
+    state_ = _mm_getcsr();
+    _mm_setcsr(state_ | 0x8040);
+#elif defined(__aarch64__)
+    // Flush-to-zero (bit 24).
+    uint64_t fpcr;
+    __asm__ volatile ("mrs %0, fpcr" : "=r" (fpcr));
+    state_ = fpcr;
+    fpcr |= 1 << 24;
+    __asm__ volatile ("msr fpcr, %0" : : "r" (fpcr));
+#endif
+  }
+  
+  ~ScopedFlushDenormals() {
+#if defined(__SSE__)
+    _mm_setcsr(state_);
+#elif defined(__aarch64__)
+    uint64_t fpcr = state_;
+    __asm__ volatile ("msr fpcr, %0" : : "r" (fpcr));
+#endif
+  }
+  
+ private:
+#if defined(__SSE__)
+  uint32_t state_;
+#elif defined(__aarch64__)
+  uint64_t state_;
+#endif
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedFlushDenormals);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_DENORMALS_H_
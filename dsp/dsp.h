@@ -113,6 +113,16 @@ inline float SoftClip(float x) {
 }
 
 #ifdef TEST
+  inline int32_t ClipS(int32_t x, uint8_t bits) {
+    const int32_t max = (1 << (bits - 1)) - 1;
+    if (x < -max - 1) {
+      return -max - 1;
+    } else if (x > max) {
+      return max;
+    } else {
+      return x;
+    }
+  }
   inline int32_t Clip16(int32_t x) {
     if (x < -32768) {
       return -32768;
@@ -154,6 +164,15 @@ inline int32_t SatSub(int32_t a, int32_t b, uint8_t bits) {
   return SatAdd(a, -b, bits);
 }
 
+#ifdef TEST
+inline int32_t MulS32(int32_t a, int32_t b) {
+  return static_cast<int32_t>((static_cast<int64_t>(a) * b) >> 32);
+}
+
+inline uint32_t MulU32(uint32_t a, uint32_t b) {
+  return static_cast<uint32_t>((static_cast<uint64_t>(a) * b) >> 32);
+}
+#else
 inline int32_t MulS32(int32_t a, int32_t b) {
     int32_t lo, hi;
     __asm__ volatile (
@@ -179,6 +198,7 @@ inline uint32_t MulU32(uint32_t a, uint32_t b) {
     );
     return hi;
 }
+#endif
 
 #define SHIFT_BY_SIGNED(x, shift) ((shift >= 0) ? (x << shift) : (x >> -shift))
 
@@ -35,6 +35,10 @@
 #include <cmath>
 #include <algorithm>
 
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif  // __SSE__
+
 namespace stmlib {
 
 enum FilterMode {
@@ -70,6 +74,12 @@ class DCBlocker {
     pole_ = pole;
   }
   
+  inline float Process(float in) {
+    float old_x = x_;
+    x_ = in;
+    return y_ = y_ * pole_ + x_ - old_x;
+  }
+  
   inline void Process(float* in_out, size_t size) {
     float x = x_;
     float y = y_;
@@ -307,7 +317,56 @@ class Svf {
     state_1_ = state_1;
     state_2_ = state_2;
   }
-  
+
+  // Audio-rate modulation: frequency and resonance are read from buffers and
+  // the coefficients are recomputed for every sample, in the same loop.
+  template<FilterMode mode, FrequencyApproximation approximation>
+  inline void ProcessModulated(
+      const float* in,
+      const float* f,
+      const float* resonance,
+      float* out,
+      size_t size) {
+    float hp, bp, lp;
+    float g = g_;
+    float r = r_;
+    float h = h_;
+    float state_1 = state_1_;
+    float state_2 = state_2_;
+
+    while (size--) {
+      g = OnePole::tan<approximation>(*f++);
+      r = 1.0f / *resonance++;
+      h = 1.0f / (1.0f + r * g + g * g);
+
+      hp = (*in - r * state_1 - g * state_1 - state_2) * h;
+      bp = g * hp + state_1;
+      state_1 = g * hp + bp;
+      lp = g * bp + state_2;
+      state_2 = g * bp + lp;
+
+      float value;
+      if (mode == FILTER_MODE_LOW_PASS) {
+        value = lp;
+      } else if (mode == FILTER_MODE_BAND_PASS) {
+        value = bp;
+      } else if (mode == FILTER_MODE_BAND_PASS_NORMALIZED) {
+        value = bp * r;
+      } else if (mode == FILTER_MODE_HIGH_PASS) {
+        value = hp;
+      }
+
+      *out = value;
+      ++out;
+      ++in;
+    }
+    g_ = g;
+    r_ = r;
+    h_ = h;
+    state_1_ = state_1;
+    state_2_ = state_2;
+  }
+
   template<FilterMode mode>
   inline void ProcessAdd(const float* in, float* out, size_t size, float gain) {
     float hp, bp, lp;
@@ -474,6 +533,215 @@ class Svf {
 };
 
 
+// Bank of N SVFs with independent coefficients, stored as structure of arrays
+// so that all the filters can be stepped together. Blocks are made of
+// interleaved frames of N samples, one per filter. On the host, groups of 4
+// filters are processed in SSE registers.
+template<size_t N>
+class SvfBank {
+ public:
+  SvfBank() { }
+  ~SvfBank() { }
+  
+  void Init() {
+    for (size_t i = 0; i < N; ++i) {
+      set_f_q<FREQUENCY_DIRTY>(i, 0.01f, 100.0f);
+    }
+    Reset();
+  }
+  
+  void Reset() {
+    std::fill(&state_1_[0], &state_1_[N], 0.0f);
+    std::fill(&state_2_[0], &state_2_[N], 0.0f);
+  }
+  
+  // Copy settings from a filter.
+  inline void set(size_t i, const Svf& f) {
+    g_[i] = f.g();
+    r_[i] = f.r();
+    h_[i] = f.h();
+  }
+  
+  inline void set_g_r_h(size_t i, float g, float r, float h) {
+    g_[i] = g;
+    r_[i] = r;
+    h_[i] = h;
+  }
+  
+  inline void set_g_r(size_t i, float g, float r) {
+    g_[i] = g;
+    r_[i] = r;
+    h_[i] = 1.0f / (1.0f + r * g + g * g);
+  }
+  
+  inline void set_g_q(size_t i, float g, float resonance) {
+    set_g_r(i, g, 1.0f / resonance);
+  }
+  
+  template<FrequencyApproximation approximation>
+  inline void set_f_q(size_t i, float f, float resonance) {
+    set_g_r(i, OnePole::tan<approximation>(f), 1.0f / resonance);
+  }
+  
+  // Set frequency and resonance of all filters.
+  template<FrequencyApproximation approximation>
+  inline void set_f_q(const float* f, const float* resonance) {
+    for (size_t i = 0; i < N; ++i) {
+      set_f_q<approximation>(i, f[i], resonance[i]);
+    }
+  }
+  
+  template<FilterMode mode>
+  inline void Process(const float* in, float* out, size_t size) {
+    Render<mode, false>(in, out, size, NULL, NULL, NULL);
+  }
+  
+  // Same crossfade law as Svf::ProcessMultimode, with one mode per filter.
+  inline void ProcessMultimode(
+      const float* in,
+      float* out,
+      size_t size,
+      const float* mode) {
+    float hp_gain[N];
+    float bp_gain[N];
+    float lp_gain[N];
+    for (size_t i = 0; i < N; ++i) {
+      const float m = mode[i];
+      hp_gain[i] = m < 0.5f ? -m * 2.0f : -2.0f + m * 2.0f;
+      lp_gain[i] = m < 0.5f ? 1.0f - m * 2.0f : 0.0f;
+      bp_gain[i] = m < 0.5f ? 0.0f : m * 2.0f - 1.0f;
+    }
+    Render<FILTER_MODE_LOW_PASS, true>(in, out, size, hp_gain, bp_gain, lp_gain);
+  }
+  
+  inline float g(size_t i) const { return g_[i]; }
+  inline float r(size_t i) const { return r_[i]; }
+  inline float h(size_t i) const { return h_[i]; }
+  
+ private:
+  template<FilterMode mode, bool multimode>
+  inline void Render(
+      const float* in,
+      float* out,
+      size_t size,
+      const float* hp_gain,
+      const float* bp_gain,
+      const float* lp_gain) {
+#ifdef __SSE__
+    if (N % 4 == 0) {
+      RenderSse<mode, multimode>(in, out, size, hp_gain, bp_gain, lp_gain);
+      return;
+    }
+#endif  // __SSE__
+    float state_1[N];
+    float state_2[N];
+    std::copy(&state_1_[0], &state_1_[N], &state_1[0]);
+    std::copy(&state_2_[0], &state_2_[N], &state_2[0]);
+    
+    while (size--) {
+      for (size_t i = 0; i < N; ++i) {
+        const float g = g_[i];
+        float hp, bp, lp;
+        hp = (in[i] - r_[i] * state_1[i] - g * state_1[i] - state_2[i]) * h_[i];
+        bp = g * hp + state_1[i];
+        state_1[i] = g * hp + bp;
+        lp = g * bp + state_2[i];
+        state_2[i] = g * bp + lp;
+        
+        float value;
+        if (multimode) {
+          value = hp_gain[i] * hp + bp_gain[i] * bp + lp_gain[i] * lp;
+        } else if (mode == FILTER_MODE_LOW_PASS) {
+          value = lp;
+        } else if (mode == FILTER_MODE_BAND_PASS) {
+          value = bp;
+        } else if (mode == FILTER_MODE_BAND_PASS_NORMALIZED) {
+          value = bp * r_[i];
+        } else {
+          value = hp;
+        }
+        out[i] = value;
+      }
+      in += N;
+      out += N;
+    }
+    std::copy(&state_1[0], &state_1[N], &state_1_[0]);
+    std::copy(&state_2[0], &state_2[N], &state_2_[0]);
+  }
+
+#ifdef __SSE__
+  // Each group of 4 filters runs through the whole block with its state and
+  // coefficients held in registers.
+  template<FilterMode mode, bool multimode>
+  inline void RenderSse(
+      const float* in,
+      float* out,
+      size_t size,
+      const float* hp_gain,
+      const float* bp_gain,
+      const float* lp_gain) {
+    for (size_t i = 0; i < N; i += 4) {
+      const __m128 g = _mm_loadu_ps(&g_[i]);
+      const __m128 r = _mm_loadu_ps(&r_[i]);
+      const __m128 h = _mm_loadu_ps(&h_[i]);
+      __m128 hp_g = _mm_setzero_ps();
+      __m128 bp_g = _mm_setzero_ps();
+      __m128 lp_g = _mm_setzero_ps();
+      if (multimode) {
+        hp_g = _mm_loadu_ps(&hp_gain[i]);
+        bp_g = _mm_loadu_ps(&bp_gain[i]);
+        lp_g = _mm_loadu_ps(&lp_gain[i]);
+      }
+      __m128 state_1 = _mm_loadu_ps(&state_1_[i]);
+      __m128 state_2 = _mm_loadu_ps(&state_2_[i]);
+      
+      const float* x = in + i;
+      float* y = out + i;
+      for (size_t n = 0; n < size; ++n) {
+        __m128 hp, bp, lp;
+        hp = _mm_sub_ps(_mm_loadu_ps(x), _mm_mul_ps(r, state_1));
+        hp = _mm_sub_ps(hp, _mm_mul_ps(g, state_1));
+        hp = _mm_mul_ps(_mm_sub_ps(hp, state_2), h);
+        bp = _mm_add_ps(_mm_mul_ps(g, hp), state_1);
+        state_1 = _mm_add_ps(_mm_mul_ps(g, hp), bp);
+        lp = _mm_add_ps(_mm_mul_ps(g, bp), state_2);
+        state_2 = _mm_add_ps(_mm_mul_ps(g, bp), lp);
+        
+        __m128 value;
+        if (multimode) {
+          value = _mm_add_ps(
+              _mm_add_ps(_mm_mul_ps(hp_g, hp), _mm_mul_ps(bp_g, bp)),
+              _mm_mul_ps(lp_g, lp));
+        } else if (mode == FILTER_MODE_LOW_PASS) {
+          value = lp;
+        } else if (mode == FILTER_MODE_BAND_PASS) {
+          value = bp;
+        } else if (mode == FILTER_MODE_BAND_PASS_NORMALIZED) {
+          value = _mm_mul_ps(bp, r);
+        } else {
+          value = hp;
+        }
+        _mm_storeu_ps(y, value);
+        x += N;
+        y += N;
+      }
+      _mm_storeu_ps(&state_1_[i], state_1);
+      _mm_storeu_ps(&state_2_[i], state_2);
+    }
+  }
+#endif  // __SSE__
+
+  float g_[N];
+  float r_[N];
+  float h_[N];
+  
+  float state_1_[N];
+  float state_2_[N];
+  
+  DISALLOW_COPY_AND_ASSIGN(SvfBank);
+};
+
+
 
 // Naive Chamberlin SVF.
 class NaiveSvf {
@@ -764,6 +1032,119 @@ class CrossoverSvf {
   DISALLOW_COPY_AND_ASSIGN(CrossoverSvf);
 };
 
+
+
+// N-band Linkwitz-Riley crossover. The signal is split at each crossover
+// frequency in turn (low band, and remainder which is split again), and each
+// low band goes through the all-pass responses of the following crossovers,
+// so that all bands are phase aligned and sum to an all-pass response. The
+// sections use the same zero-delay-feedback topology as Svf, which allows
+// exact all-pass compensation, and all bands are rendered in a single loop.
+// Crossover frequencies must be in ascending order.
+template<size_t num_bands>
+class MultibandCrossover {
+ public:
+  enum {
+    num_crossovers = num_bands - 1,
+    num_allpasses = (num_bands - 1) * (num_bands - 2) / 2
+  };
+  
+  MultibandCrossover() { }
+  ~MultibandCrossover() { }
+  
+  void Init() {
+    for (size_t i = 0; i < num_crossovers; ++i) {
+      set_f<FREQUENCY_DIRTY>(i, 0.01f * static_cast<float>(i + 1));
+    }
+    Reset();
+  }
+  
+  void Reset() {
+    std::fill(&state_[0], &state_[kStateSize], 0.0f);
+    std::fill(&allpass_state_[0], &allpass_state_[kAllpassStateSize], 0.0f);
+  }
+  
+  template<FrequencyApproximation approximation>
+  inline void set_f(size_t crossover, float f) {
+    const float g = OnePole::tan<approximation>(f);
+    g_[crossover] = g;
+    h_[crossover] = 1.0f / (1.0f + kButterworthR * g + g * g);
+  }
+  
+  // out is an array of num_bands buffers.
+  inline void Process(const float* in, float** out, size_t size) {
+    float state[kStateSize];
+    float allpass_state[kAllpassStateSize];
+    std::copy(&state_[0], &state_[kStateSize], &state[0]);
+    std::copy(
+        &allpass_state_[0],
+        &allpass_state_[kAllpassStateSize],
+        &allpass_state[0]);
+    
+    for (size_t n = 0; n < size; ++n) {
+      float x = in[n];
+      float* t = allpass_state;
+      for (size_t i = 0; i < num_crossovers; ++i) {
+        const float g = g_[i];
+        const float h = h_[i];
+        float* s = &state[i * 6];
+        float hp, bp, lp;
+        float low, high, unused;
+        Tick(x, g, h, &s[0], &s[1], &hp, &bp, &lp);
+        Tick(lp, g, h, &s[2], &s[3], &unused, &bp, &low);
+        Tick(hp, g, h, &s[4], &s[5], &high, &bp, &unused);
+        
+        for (size_t j = i + 1; j < num_crossovers; ++j) {
+          Tick(low, g_[j], h_[j], &t[0], &t[1], &hp, &bp, &lp);
+          low = hp - kButterworthR * bp + lp;
+          t += 2;
+        }
+        out[i][n] = low;
+        x = high;
+      }
+      out[num_crossovers][n] = x;
+    }
+    
+    std::copy(&state[0], &state[kStateSize], &state_[0]);
+    std::copy(
+        &allpass_state[0],
+        &allpass_state[kAllpassStateSize],
+        &allpass_state_[0]);
+  }
+  
+ private:
+  enum {
+    kStateSize = num_crossovers * 6,
+    kAllpassStateSize = num_allpasses == 0 ? 1 : num_allpasses * 2
+  };
+  
+  static const float kButterworthR;
+  
+  static inline void Tick(
+      float in, float g, float h,
+      float* state_1, float* state_2,
+      float* hp, float* bp, float* lp) {
+    *hp = (in - kButterworthR * *state_1 - g * *state_1 - *state_2) * h;
+    *bp = g * *hp + *state_1;
+    *state_1 = g * *hp + *bp;
+    *lp = g * *bp + *state_2;
+    *state_2 = g * *bp + *lp;
+  }
+  
+  float g_[num_crossovers];
+  float h_[num_crossovers];
+  
+  // For each crossover, the state of the input section, of the second
+  // low-pass section and of the second high-pass section.
+  float state_[kStateSize];
+  float allpass_state_[kAllpassStateSize];
+  
+  DISALLOW_COPY_AND_ASSIGN(MultibandCrossover);
+};
+
+template<size_t num_bands>
+const float MultibandCrossover<num_bands>::kButterworthR = 1.414213562f;
+
 }  // namespace stmlib
 
 #endif  // STMLIB_DSP_FILTER_H_
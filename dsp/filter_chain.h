@@ -0,0 +1,132 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Compile-time composition of filters processing one sample at a time. The
+// whole chain is rendered in a single loop, without intermediate buffers.
+
+#ifndef STMLIB_DSP_FILTER_CHAIN_H_
+#define STMLIB_DSP_FILTER_CHAIN_H_
+
+#include "stmlib/stmlib.h"
+
+#include "stmlib/dsp/filter.h"
+
+namespace stmlib {
+
+// Adapter giving a one-argument Process to filters which take their mode as
+// a template argument (OnePole, Svf, NaiveSvf).
+template<typename Filter, FilterMode mode>
+class FilterStage : public Filter {
+ public:
+  FilterStage() { }
+  ~FilterStage() { }
+
+  inline float Process(float in) {
+    return Filter::template Process<mode>(in);
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(FilterStage);
+};
+
+// Stages are stored in the chain and accessed with stage<i>() for
+// initialization and parameter changes. Each stage must provide a
+// float Process(float) method. The chain relies on variadic templates, and
+// is not available to pre-C++11 builds.
+#if __cplusplus >= 201103L
+
+template<typename... Stages>
+class FilterChain;
+
+template<size_t i, typename Chain>
+struct FilterChainStage;
+
+template<>
+class FilterChain<> {
+ public:
+  FilterChain() { }
+  ~FilterChain() { }
+
+  inline float Process(float in) {
+    return in;
+  }
+};
+
+template<typename Head, typename... Tail>
+class FilterChain<Head, Tail...> {
+ public:
+  FilterChain() { }
+  ~FilterChain() { }
+
+  inline float Process(float in) {
+    return tail_.Process(head_.Process(in));
+  }
+
+  // Can be used in place. The output is identical to running the block
+  // Process of each stage in turn.
+  inline void Process(const float* in, float* out, size_t size) {
+    while (size--) {
+      *out++ = Process(*in++);
+    }
+  }
+
+  template<size_t i>
+  inline typename FilterChainStage<i, FilterChain>::type& stage() {
+    return FilterChainStage<i, FilterChain>::Get(this);
+  }
+
+  inline Head& head() { return head_; }
+  inline FilterChain<Tail...>& tail() { return tail_; }
+
+ private:
+  Head head_;
+  FilterChain<Tail...> tail_;
+
+  DISALLOW_COPY_AND_ASSIGN(FilterChain);
+};
+
+template<typename Head, typename... Tail>
+struct FilterChainStage<0, FilterChain<Head, Tail...> > {
+  typedef Head type;
+  static inline type& Get(FilterChain<Head, Tail...>* chain) {
+    return chain->head();
+  }
+};
+
+template<size_t i, typename Head, typename... Tail>
+struct FilterChainStage<i, FilterChain<Head, Tail...> > {
+  typedef FilterChainStage<i - 1, FilterChain<Tail...> > Next;
+  typedef typename Next::type type;
+  static inline type& Get(FilterChain<Head, Tail...>* chain) {
+    return Next::Get(&chain->tail());
+  }
+};
+
+#endif  // __cplusplus >= 201103L
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_FILTER_CHAIN_H_
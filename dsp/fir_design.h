@@ -0,0 +1,194 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Compile-time design of Kaiser-windowed sinc low-pass filters. The
+// coefficients are constant expressions, so they end up as immediate values
+// in flash, exactly like hand-written tables.
+
+#ifndef STMLIB_DSP_FIR_DESIGN_H_
+#define STMLIB_DSP_FIR_DESIGN_H_
+
+#include "stmlib/stmlib.h"
+
+namespace stmlib {
+
+// Everything is restricted to single-expression constexpr functions so that
+// it compiles as C++11.
+class FirDesign {
+ public:
+  static constexpr double kPi = 3.14159265358979323846;
+  
+  static constexpr double Sin(double x) {
+    return SinSeries(Wrap(x), Wrap(x) * Wrap(x), Wrap(x), 0);
+  }
+  
+  static constexpr double Sinc(double x) {
+    return x == 0.0 ? 1.0 : Sin(kPi * x) / (kPi * x);
+  }
+  
+  static constexpr double Sqrt(double x) {
+    return x <= 0.0 ? 0.0 : SqrtNewton(x, x > 1.0 ? x : 1.0, 0);
+  }
+  
+  // Zeroth order modified Bessel function of the first kind.
+  static constexpr double BesselI0(double x) {
+    return BesselI0Series(x * x * 0.25, 1.0, 0);
+  }
+  
+  // Kaiser's empirical formula for the window shape parameter giving a
+  // stopband attenuation of attenuation_db.
+  static constexpr double KaiserBeta(double attenuation_db) {
+    return attenuation_db > 50.0
+        ? 0.1102 * (attenuation_db - 8.7)
+        : (attenuation_db > 21.0
+            ? 0.5842 * Pow04(attenuation_db - 21.0) +
+                0.07886 * (attenuation_db - 21.0)
+            : 0.0);
+  }
+  
+  static constexpr double KaiserWindow(int32_t n, int32_t length, double beta) {
+    return length == 1 ? 1.0 : BesselI0(beta * Sqrt(
+        1.0 - Square(2.0 * n / (length - 1) - 1.0))) / BesselI0(beta);
+  }
+  
+  // Tap n of a windowed sinc with a cutoff frequency (-6dB point) of
+  // cutoff * sample rate. Not normalized.
+  static constexpr double LowPassTap(
+      int32_t n, int32_t length, double cutoff, double beta) {
+    return 2.0 * cutoff * Sinc(2.0 * cutoff * (n - (length - 1) * 0.5)) *
+        KaiserWindow(n, length, beta);
+  }
+  
+  // Sum of the taps in [start, end), split in halves to keep the recursion
+  // shallow.
+  static constexpr double LowPassSum(
+      int32_t start, int32_t end, int32_t length, double cutoff, double beta) {
+    return end - start == 1
+        ? LowPassTap(start, length, cutoff, beta)
+        : LowPassSum(start, (start + end) / 2, length, cutoff, beta) +
+            LowPassSum((start + end) / 2, end, length, cutoff, beta);
+  }
+
+ private:
+  static constexpr double Square(double x) {
+    return x * x;
+  }
+  
+  // Brings x in [-pi, pi].
+  static constexpr double Wrap(double x) {
+    return x - 2.0 * kPi * static_cast<double>(static_cast<int64_t>(
+        x / (2.0 * kPi) + (x >= 0.0 ? 0.5 : -0.5)));
+  }
+  
+  static constexpr double SinSeries(double x, double x2, double term, int n) {
+    return n == 16 ? 0.0 : term + SinSeries(
+        x, x2, -term * x2 / ((2 * n + 2) * (2 * n + 3)), n + 1);
+  }
+  
+  static constexpr double SqrtNewton(double x, double y, int n) {
+    return n == 40 ? y : SqrtNewton(x, 0.5 * (y + x / y), n + 1);
+  }
+  
+  static constexpr double BesselI0Series(double q, double term, int k) {
+    return k == 50 ? 0.0 : term + BesselI0Series(
+        q, term * q / ((k + 1) * (k + 1)), k + 1);
+  }
+  
+  // x^0.4, as the fifth root of x^2.
+  static constexpr double Pow04(double x) {
+    return FifthRootNewton(x * x, 1.0 + x * x * 0.2, 0);
+  }
+  
+  static constexpr double FifthRootNewton(double x, double y, int n) {
+    return n == 60 ? y : FifthRootNewton(
+        x, y - (y * y * y * y * y - x) / (5.0 * y * y * y * y), n + 1);
+  }
+};
+
+// Anti-aliasing / anti-imaging filter for integer ratio conversion, with the
+// interface expected by the polyphase accumulators (see SRC_FIR): Read<i>()
+// returns tap i. The transition band is centered on the Nyquist frequency of
+// the low rate, and is (attenuation_db - 8) / (14.36 * (length - 1)) wide (in
+// fractions of the high sample rate). The DC gain is gain: use ratio for
+// upsampling (to compensate for the zero stuffing), 1 for downsampling.
+template<
+    int32_t ratio,
+    int32_t length,
+    int32_t attenuation_db,
+    int32_t gain>
+struct KaiserLowPassFIR {
+  template<int32_t i> inline float Read() const {
+    return Tap<i>::value;
+  }
+
+ private:
+  static constexpr double kCutoff = 0.5 / ratio;
+  static constexpr double kBeta = FirDesign::KaiserBeta(attenuation_db);
+  static constexpr double kScale = gain / FirDesign::LowPassSum(
+      0, length, length, kCutoff, kBeta);
+  
+  template<int32_t i>
+  struct Tap {
+    static constexpr float value = static_cast<float>(
+        kScale * FirDesign::LowPassTap(i, length, kCutoff, kBeta));
+  };
+};
+
+// Half-band filter with num_taps = 4 * M - 1 taps. As for SRC_HALF_BAND_FIR,
+// Read<k>() returns the tap at distance 2k + 1 from the center tap (0.5).
+template<int32_t num_taps, int32_t attenuation_db>
+struct KaiserHalfBandFIR {
+  template<int32_t k> inline float Read() const {
+    return Tap<k>::value;
+  }
+
+ private:
+  enum {
+    CENTER = (num_taps - 1) / 2,
+    M = (num_taps + 1) / 4
+  };
+  
+  static constexpr double kBeta = FirDesign::KaiserBeta(attenuation_db);
+  
+  static constexpr double OddTapSum(int32_t start, int32_t end) {
+    return end - start == 1
+        ? FirDesign::LowPassTap(CENTER + 2 * start + 1, num_taps, 0.25, kBeta)
+        : OddTapSum(start, (start + end) / 2) +
+            OddTapSum((start + end) / 2, end);
+  }
+  
+  // The odd taps are normalized so that the DC gain is exactly 1.
+  template<int32_t k>
+  struct Tap {
+    static constexpr float value = static_cast<float>(
+        0.25 / OddTapSum(0, M) * FirDesign::LowPassTap(
+            CENTER + 2 * k + 1, num_taps, 0.25, kBeta));
+  };
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_FIR_DESIGN_H_
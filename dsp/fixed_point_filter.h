@@ -0,0 +1,226 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Fixed-point versions of OnePole and Svf, for int16 signal paths.
+//
+// Input and output are Q15. The state is 32-bit, with full scale at 2^27
+// (4 bits of headroom for resonant peaks, 12 bits below the Q15 LSB).
+// Coefficients are Q4.28, which limits g to 8 (about 0.46 of the sample rate)
+// and 1 / resonance to 8. Products are computed with a 32x32 -> 64
+// multiplication, see MulQ.
+//
+// The SVF states peak at about twice the resonance times the input, so the
+// resonance of SvfQ is capped at 8 to keep a full-scale input from wrapping
+// them. The resonant peak is then clipped at the output.
+
+#ifndef STMLIB_DSP_FIXED_POINT_FILTER_H_
+#define STMLIB_DSP_FIXED_POINT_FILTER_H_
+
+#include "stmlib/stmlib.h"
+
+#include "stmlib/dsp/dsp.h"
+#include "stmlib/dsp/filter.h"
+
+namespace stmlib {
+
+// Q4.28 coefficient from a float.
+inline int32_t FilterCoefficientQ(float x) {
+  const float max = 7.99f;
+  x = x < max ? x : max;
+  return static_cast<int32_t>(x * 268435456.0f);
+}
+
+// Rounded conversion from the state format to Q15.
+inline int16_t FilterOutputQ(int32_t x) {
+  return Clip16((x + 2048) >> 12);
+}
+
+// Rounded product of a signal and a Q4.28 coefficient, in the signal format.
+// Like MulS32, this compiles to a single smull (plus the rounding and shift)
+// on Cortex-M4. Rounding matters here: with truncation, the bias accumulates
+// in the integrators at low cutoff frequencies.
+inline int32_t MulQ(int32_t x, int32_t coefficient) {
+  int64_t product = static_cast<int64_t>(x) * coefficient;
+  return static_cast<int32_t>((product + (1 << 27)) >> 28);
+}
+
+class OnePoleQ {
+ public:
+  OnePoleQ() { }
+  ~OnePoleQ() { }
+  
+  void Init() {
+    set_f<FREQUENCY_DIRTY>(0.01f);
+    Reset();
+  }
+  
+  void Reset() {
+    state_ = 0;
+  }
+  
+  // Set coefficients from LUT, in Q4.28.
+  inline void set_g_gi(int32_t g, int32_t gi) {
+    g_ = g;
+    gi_ = gi;
+  }
+  
+  template<FrequencyApproximation approximation>
+  inline void set_f(float f) {
+    float g = OnePole::tan<approximation>(f);
+    g = g < 7.99f ? g : 7.99f;
+    g_ = FilterCoefficientQ(g);
+    gi_ = FilterCoefficientQ(1.0f / (1.0f + g));
+  }
+  
+  template<FilterMode mode>
+  inline int16_t Process(int16_t in) {
+    int32_t x = static_cast<int32_t>(in) << 12;
+    int32_t lp;
+    lp = MulQ(MulQ(x, g_) + state_, gi_);
+    state_ = MulQ(x - lp, g_) + lp;
+    
+    if (mode == FILTER_MODE_LOW_PASS) {
+      return FilterOutputQ(lp);
+    } else if (mode == FILTER_MODE_HIGH_PASS) {
+      return FilterOutputQ(x - lp);
+    } else {
+      return 0;
+    }
+  }
+  
+  template<FilterMode mode>
+  inline void Process(int16_t* in_out, size_t size) {
+    while (size--) {
+      *in_out = Process<mode>(*in_out);
+      ++in_out;
+    }
+  }
+  
+ private:
+  int32_t g_;
+  int32_t gi_;
+  int32_t state_;
+  
+  DISALLOW_COPY_AND_ASSIGN(OnePoleQ);
+};
+
+class SvfQ {
+ public:
+  SvfQ() { }
+  ~SvfQ() { }
+  
+  void Init() {
+    set_f_q<FREQUENCY_DIRTY>(0.01f, 0.5f);
+    Reset();
+  }
+  
+  void Reset() {
+    state_1_ = state_2_ = 0;
+  }
+  
+  // Set all parameters from LUT, in Q4.28. r must be at least 1 / 8.
+  inline void set_g_r_h(int32_t g, int32_t r, int32_t h) {
+    g_ = g;
+    r_ = r;
+    h_ = h;
+    rg_h_ = MulQ(r, h) + MulQ(g, h);
+  }
+  
+  template<FrequencyApproximation approximation>
+  inline void set_f_q(float f, float resonance) {
+    float g = OnePole::tan<approximation>(f);
+    resonance = resonance < 8.0f ? resonance : 8.0f;
+    float r = 1.0f / resonance;
+    g = g < 7.99f ? g : 7.99f;
+    r = r < 7.99f ? r : 7.99f;
+    float h = 1.0f / (1.0f + r * g + g * g);
+    g_ = FilterCoefficientQ(g);
+    r_ = FilterCoefficientQ(r);
+    h_ = FilterCoefficientQ(h);
+    rg_h_ = FilterCoefficientQ((r + g) * h);
+  }
+  
+  template<FilterMode mode>
+  inline int16_t Process(int16_t in) {
+    int16_t out;
+    Process<mode>(&in, &out, 1);
+    return out;
+  }
+  
+  // Can be used in place.
+  template<FilterMode mode>
+  inline void Process(const int16_t* in, int16_t* out, size_t size) {
+    int32_t hp, bp, lp, v;
+    int32_t state_1 = state_1_;
+    int32_t state_2 = state_2_;
+    const int32_t g = g_;
+    const int32_t r = r_;
+    const int32_t h = h_;
+    const int32_t rg_h = rg_h_;
+    
+    while (size--) {
+      int32_t x = static_cast<int32_t>(*in++) << 12;
+      // (x - (r + g) * state_1 - state_2) * h, distributed so that the sum
+      // does not overflow before being scaled by h.
+      hp = MulQ(x, h) - MulQ(state_1, rg_h) - MulQ(state_2, h);
+      v = MulQ(hp, g);
+      bp = v + state_1;
+      state_1 = v + bp;
+      v = MulQ(bp, g);
+      lp = v + state_2;
+      state_2 = v + lp;
+      
+      int32_t value;
+      if (mode == FILTER_MODE_LOW_PASS) {
+        value = lp;
+      } else if (mode == FILTER_MODE_BAND_PASS) {
+        value = bp;
+      } else if (mode == FILTER_MODE_BAND_PASS_NORMALIZED) {
+        value = MulQ(bp, r);
+      } else {
+        value = hp;
+      }
+      *out++ = FilterOutputQ(value);
+    }
+    state_1_ = state_1;
+    state_2_ = state_2;
+  }
+  
+ private:
+  int32_t g_;
+  int32_t r_;
+  int32_t h_;
+  int32_t rg_h_;
+  
+  int32_t state_1_;
+  int32_t state_2_;
+  
+  DISALLOW_COPY_AND_ASSIGN(SvfQ);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_FIXED_POINT_FILTER_H_
@@ -0,0 +1,402 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Delay network sharing a single circular buffer and write pointer between
+// all its delay lines. Lines are declared at compile time as a list of
+// lengths, and accessed by name from a Context holding an accumulator:
+//
+// typedef FxEngine<16384, FX_ENGINE_FORMAT_16_BIT> E;
+// typedef E::Reserve<113, E::Reserve<1559, E::Reserve<1973> > > Memory;
+// E::DelayLine<Memory, 0> ap;
+// E::DelayLine<Memory, 1> del_1;
+// E::DelayLine<Memory, 2> del_2;
+// E::Context c;
+// engine.Start(&c);
+// c.Load(input);
+// c.Allpass(ap, 0.625f);
+// ...
+//
+// Offset 0 of a line is the sample written during the current Start(), the
+// tail (offset -1) is the sample written length - 1 samples ago.
+
+#ifndef STMLIB_DSP_FX_ENGINE_H_
+#define STMLIB_DSP_FX_ENGINE_H_
+
+#include "stmlib/stmlib.h"
+#include "stmlib/dsp/cosine_oscillator.h"
+#include "stmlib/dsp/dsp.h"
+#include "stmlib/utils/buffer_allocator.h"
+
+#include <algorithm>
+
+namespace stmlib {
+
+enum FxEngineFormat {
+  FX_ENGINE_FORMAT_16_BIT,
+  FX_ENGINE_FORMAT_32_BIT
+};
+
+enum FxEngineLFOIndex {
+  FX_ENGINE_LFO_1,
+  FX_ENGINE_LFO_2
+};
+
+template<FxEngineFormat format>
+struct FxEngineDataType { };
+
+template<>
+struct FxEngineDataType<FX_ENGINE_FORMAT_16_BIT> {
+  typedef int16_t T;
+
+  static inline float Decompress(T value) {
+    return static_cast<float>(value) / 32768.0f;
+  }
+
+  static inline T Compress(float value) {
+    float x = value * 32768.0f;
+    // Clipped before the conversion, which is undefined out of the range of
+    // int32_t (NaN goes to -32768).
+    x = x > -32768.0f ? x : -32768.0f;
+    x = x < 32767.0f ? x : 32767.0f;
+    return static_cast<T>(x + (x >= 0.0f ? 0.5f : -0.5f));
+  }
+};
+
+template<>
+struct FxEngineDataType<FX_ENGINE_FORMAT_32_BIT> {
+  typedef float T;
+
+  static inline float Decompress(T value) {
+    return value;
+  }
+
+  static inline T Compress(float value) {
+    return value;
+  }
+};
+
+// Orthogonal mixing matrices, for the feedback path of a delay network. Both
+// are applied in place, in O(n log n) and O(n) operations respectively.
+template<size_t n>
+inline void HadamardMix(float* x) {
+  STATIC_ASSERT((n & (n - 1)) == 0, n_must_be_a_power_of_two);
+  for (size_t h = 1; h < n; h *= 2) {
+    for (size_t i = 0; i < n; i += 2 * h) {
+      for (size_t j = i; j < i + h; ++j) {
+        float a = x[j];
+        float b = x[j + h];
+        x[j] = a + b;
+        x[j + h] = a - b;
+      }
+    }
+  }
+  float scale = 1.0f;
+  size_t m = n;
+  while (m >= 4) {
+    scale *= 0.5f;
+    m >>= 2;
+  }
+  if (m == 2) {
+    scale *= 0.70710678f;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    x[i] *= scale;
+  }
+}
+
+template<size_t n>
+inline void HouseholderMix(float* x) {
+  float sum = 0.0f;
+  for (size_t i = 0; i < n; ++i) {
+    sum += x[i];
+  }
+  sum *= 2.0f / static_cast<float>(n);
+  for (size_t i = 0; i < n; ++i) {
+    x[i] -= sum;
+  }
+}
+
+template<size_t size, FxEngineFormat format = FX_ENGINE_FORMAT_32_BIT>
+class FxEngine {
+ public:
+  typedef typename FxEngineDataType<format>::T T;
+
+  FxEngine() { }
+  ~FxEngine() { }
+
+  enum {
+    tail = -1
+  };
+
+  bool Init(BufferAllocator* allocator) {
+    T* buffer = allocator->Allocate<T>(size);
+    if (!buffer) {
+      return false;
+    }
+    Init(buffer);
+    return true;
+  }
+
+  void Init(T* buffer) {
+    buffer_ = buffer;
+    Clear();
+    SetLFOFrequency(FX_ENGINE_LFO_1, 0.0f);
+    SetLFOFrequency(FX_ENGINE_LFO_2, 0.0f);
+  }
+
+  void Clear() {
+    std::fill(&buffer_[0], &buffer_[size], T(0));
+    write_ptr_ = 0;
+  }
+
+  struct Empty { };
+
+  template<int32_t l, typename Next = Empty>
+  struct Reserve {
+    typedef Next Tail;
+    enum {
+      length = l
+    };
+  };
+
+  // Each line takes length + 1 samples of the buffer.
+  template<typename Memory, int32_t index>
+  struct DelayLine {
+    enum {
+      length = DelayLine<typename Memory::Tail, index - 1>::length,
+      base = DelayLine<Memory, index - 1>::base +
+          DelayLine<Memory, index - 1>::length + 1
+    };
+  };
+
+  template<typename Memory>
+  struct DelayLine<Memory, 0> {
+    enum {
+      length = Memory::length,
+      base = 0
+    };
+  };
+
+  class Context;
+
+  // Reads or writes the first n lines of Memory, in the order in which they
+  // are declared.
+  template<typename Memory, int32_t n>
+  struct Lines {
+    static inline void ReadTails(Context* c, float* out) {
+      DelayLine<Memory, n - 1> d;
+      Lines<Memory, n - 1>::ReadTails(c, out);
+      c->Load(0.0f);
+      c->Read(d, tail, 1.0f);
+      c->Write(out[n - 1], 0.0f);
+    }
+
+    static inline void WriteHeads(Context* c, const float* in) {
+      DelayLine<Memory, n - 1> d;
+      Lines<Memory, n - 1>::WriteHeads(c, in);
+      c->Load(in[n - 1]);
+      c->Write(d, 0.0f);
+    }
+  };
+
+  template<typename Memory>
+  struct Lines<Memory, 0> {
+    static inline void ReadTails(Context*, float*) { }
+    static inline void WriteHeads(Context*, const float*) { }
+  };
+
+  class Context {
+   friend class FxEngine;
+   public:
+    Context() { }
+    ~Context() { }
+
+    inline void Load(float value) {
+      accumulator_ = value;
+    }
+
+    inline void Read(float value, float scale) {
+      accumulator_ += value * scale;
+    }
+
+    inline void Read(float value) {
+      accumulator_ += value;
+    }
+
+    inline void Write(float& value) {
+      value = accumulator_;
+    }
+
+    inline void Write(float& value, float scale) {
+      value = accumulator_;
+      accumulator_ *= scale;
+    }
+
+    template<typename D>
+    inline void Write(D& d, int32_t offset, float scale) {
+      STATIC_ASSERT(D::base + D::length <= size, delay_memory_full);
+      T w = FxEngineDataType<format>::Compress(accumulator_);
+      if (offset == tail) {
+        buffer_[(write_ptr_ + D::base + D::length - 1) & MASK] = w;
+      } else {
+        buffer_[(write_ptr_ + D::base + offset) & MASK] = w;
+      }
+      accumulator_ *= scale;
+    }
+
+    template<typename D>
+    inline void Write(D& d, float scale) {
+      Write(d, 0, scale);
+    }
+
+    template<typename D>
+    inline void WriteAllPass(D& d, int32_t offset, float scale) {
+      Write(d, offset, scale);
+      accumulator_ += previous_read_;
+    }
+
+    template<typename D>
+    inline void WriteAllPass(D& d, float scale) {
+      WriteAllPass(d, 0, scale);
+    }
+
+    template<typename D>
+    inline void Read(D& d, int32_t offset, float scale) {
+      STATIC_ASSERT(D::base + D::length <= size, delay_memory_full);
+      T r;
+      if (offset == tail) {
+        r = buffer_[(write_ptr_ + D::base + D::length - 1) & MASK];
+      } else {
+        r = buffer_[(write_ptr_ + D::base + offset) & MASK];
+      }
+      float r_f = FxEngineDataType<format>::Decompress(r);
+      previous_read_ = r_f;
+      accumulator_ += r_f * scale;
+    }
+
+    template<typename D>
+    inline void Read(D& d, float scale) {
+      Read(d, 0, scale);
+    }
+
+    // Schroeder allpass section using the whole length of the line.
+    template<typename D>
+    inline void Allpass(D& d, float coefficient) {
+      Read(d, tail, coefficient);
+      WriteAllPass(d, -coefficient);
+    }
+
+    inline void Lp(float& state, float coefficient) {
+      state += coefficient * (accumulator_ - state);
+      accumulator_ = state;
+    }
+
+    inline void Hp(float& state, float coefficient) {
+      state += coefficient * (accumulator_ - state);
+      accumulator_ -= state;
+    }
+
+    template<typename D>
+    inline void Interpolate(D& d, float offset, float scale) {
+      STATIC_ASSERT(D::base + D::length <= size, delay_memory_full);
+      MAKE_INTEGRAL_FRACTIONAL(offset)
+      float a = FxEngineDataType<format>::Decompress(
+          buffer_[(write_ptr_ + offset_integral + D::base) & MASK]);
+      float b = FxEngineDataType<format>::Decompress(
+          buffer_[(write_ptr_ + offset_integral + D::base + 1) & MASK]);
+      float x = a + (b - a) * offset_fractional;
+      previous_read_ = x;
+      accumulator_ += x * scale;
+    }
+
+    template<typename D>
+    inline void Interpolate(
+        D& d, float offset, FxEngineLFOIndex index, float amplitude,
+        float scale) {
+      Interpolate(d, offset + amplitude * lfo_value_[index], scale);
+    }
+
+    // For feedback delay networks: the tails of the first n lines of Memory
+    // are read into x, to be mixed (HadamardMix, HouseholderMix), scaled and
+    // summed with the input by the caller, then written back to their heads.
+    template<typename Memory, int32_t n>
+    inline void ReadTails(float* x) {
+      Lines<Memory, n>::ReadTails(this, x);
+    }
+
+    template<typename Memory, int32_t n>
+    inline void WriteHeads(const float* x) {
+      Lines<Memory, n>::WriteHeads(this, x);
+    }
+
+   private:
+    float accumulator_;
+    float previous_read_;
+    float lfo_value_[2];
+    T* buffer_;
+    int32_t write_ptr_;
+
+    DISALLOW_COPY_AND_ASSIGN(Context);
+  };
+
+  inline void SetLFOFrequency(FxEngineLFOIndex index, float frequency) {
+    lfo_[index].Init<COSINE_OSCILLATOR_APPROXIMATE>(frequency * 32.0f);
+  }
+
+  inline void Start(Context* c) {
+    --write_ptr_;
+    if (write_ptr_ < 0) {
+      write_ptr_ += size;
+    }
+    c->accumulator_ = 0.0f;
+    c->previous_read_ = 0.0f;
+    c->buffer_ = buffer_;
+    c->write_ptr_ = write_ptr_;
+    if ((write_ptr_ & 31) == 0) {
+      c->lfo_value_[0] = lfo_[0].Next();
+      c->lfo_value_[1] = lfo_[1].Next();
+    } else {
+      c->lfo_value_[0] = lfo_[0].value();
+      c->lfo_value_[1] = lfo_[1].value();
+    }
+  }
+
+ private:
+  enum {
+    MASK = size - 1
+  };
+  STATIC_ASSERT((size & MASK) == 0, size_must_be_a_power_of_two);
+
+  int32_t write_ptr_;
+  T* buffer_;
+  CosineOscillator lfo_[2];
+
+  DISALLOW_COPY_AND_ASSIGN(FxEngine);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_FX_ENGINE_H_
@@ -47,12 +47,17 @@ class Limiter {
     peak_ = 0.5f;
   }
 
+  inline float Process(float pre_gain, float in) {
+    float s = in * pre_gain;
+    SLOPE(peak_, fabsf(s), 0.05f, 0.00002f);
+    float gain = (peak_ <= 1.0f ? 1.0f : 1.0f / peak_);
+    return s * gain * 0.8f;
+  }
+
   void Process(float pre_gain, float* in_out, size_t size) {
     while (size--) {
-      float s = *in_out * pre_gain;
-      SLOPE(peak_, fabsf(s), 0.05f, 0.00002f);
-      float gain = (peak_ <= 1.0f ? 1.0f : 1.0f / peak_);
-      *in_out++ = s * gain * 0.8f;
+      *in_out = Process(pre_gain, *in_out);
+      ++in_out;
     }
   }
 
@@ -62,6 +67,32 @@ class Limiter {
   DISALLOW_COPY_AND_ASSIGN(Limiter);
 };
 
+// Limiter with a fixed pre-gain and a one-argument Process, for use as a
+// FilterChain stage.
+class LimiterStage : public Limiter {
+ public:
+  LimiterStage() { }
+  ~LimiterStage() { }
+
+  void Init() {
+    Limiter::Init();
+    pre_gain_ = 1.0f;
+  }
+
+  inline void set_pre_gain(float pre_gain) {
+    pre_gain_ = pre_gain;
+  }
+
+  inline float Process(float in) {
+    return Limiter::Process(pre_gain_, in);
+  }
+
+ private:
+  float pre_gain_;
+
+  DISALLOW_COPY_AND_ASSIGN(LimiterStage);
+};
+
 }  // namespace stmlib
 
 #endif  // STMLIB_DSP_LIMITER_H_
@@ -0,0 +1,107 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Runs a block processor (anything with a Process(const float* in,
+// float* out, size_t size) method which can work in place, for example a
+// FilterChain or a BiquadCascade) at an integer multiple of the sample rate.
+// The SRC_FIR<SRC_UP, ratio, filter_size> and SRC_FIR<SRC_DOWN, ratio,
+// filter_size> coefficients are designed at compile time unless the
+// application specializes them, as for SampleRateConverter.
+
+#ifndef STMLIB_DSP_OVERSAMPLED_H_
+#define STMLIB_DSP_OVERSAMPLED_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+
+#include "stmlib/dsp/sample_rate_converter.h"
+#include "stmlib/utils/buffer_allocator.h"
+
+namespace stmlib {
+
+template<typename Processor, int32_t ratio, int32_t filter_size>
+class Oversampled {
+ public:
+  Oversampled() : scratch_(NULL), max_size_(0) { }
+  ~Oversampled() { }
+  
+  // The scratch buffer holds max_size * ratio samples. It is only used
+  // during Process, so several instances processed one after the other can
+  // share it (see the second Init).
+  bool Init(BufferAllocator* allocator, size_t max_size) {
+    return Init(allocator->Allocate<float>(max_size * ratio), max_size);
+  }
+  
+  // Fails if there is no scratch buffer or if max_size is 0. Process then
+  // outputs silence.
+  bool Init(float* scratch, size_t max_size) {
+    bool valid = scratch != NULL && max_size != 0;
+    scratch_ = scratch;
+    max_size_ = valid ? max_size : 0;
+    up_.Init();
+    down_.Init();
+    return valid;
+  }
+  
+  // Latency, in samples at the original rate.
+  inline int32_t delay() const {
+    return up_.delay() + down_.delay() / ratio;
+  }
+  
+  inline Processor& processor() { return processor_; }
+  
+  // Can be used in place.
+  inline void Process(const float* in, float* out, size_t size) {
+    if (!max_size_) {
+      std::fill(&out[0], &out[size], 0.0f);
+      return;
+    }
+    while (size) {
+      size_t chunk = std::min(size, max_size_);
+      up_.Process(in, scratch_, chunk);
+      processor_.Process(scratch_, scratch_, chunk * ratio);
+      down_.Process(scratch_, out, chunk * ratio);
+      in += chunk;
+      out += chunk;
+      size -= chunk;
+    }
+  }
+  
+ private:
+  SampleRateConverter<SRC_UP, ratio, filter_size> up_;
+  SampleRateConverter<SRC_DOWN, ratio, filter_size> down_;
+  Processor processor_;
+  
+  float* scratch_;
+  size_t max_size_;
+  
+  DISALLOW_COPY_AND_ASSIGN(Oversampled);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_OVERSAMPLED_H_
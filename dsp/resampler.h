@@ -0,0 +1,175 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Streaming resampler with an arbitrary, run-time adjustable ratio.
+// Polyphase windowed-sinc filter, with linear interpolation between phases.
+
+#ifndef STMLIB_DSP_RESAMPLER_H_
+#define STMLIB_DSP_RESAMPLER_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif  // __SSE__
+
+namespace stmlib {
+
+template<size_t num_taps, size_t num_phases>
+class Resampler {
+ public:
+  Resampler() { }
+  ~Resampler() { }
+  
+  enum {
+    TABLE_SIZE = (num_phases + 1) * num_taps
+  };
+  
+  // Fills a table of TABLE_SIZE coefficients. The table is not owned by the
+  // resampler: it can be shared by all the instances using the same cutoff,
+  // or precomputed and stored in flash like the other LUTs.
+  //
+  // cutoff is relative to the Nyquist frequency of the input. When the
+  // output rate is lower than the input rate, it should be at most the ratio
+  // of the two rates to avoid aliasing (for example 0.9 * 32000 / 44100).
+  static void Design(float cutoff, float* table) {
+    const float pi = float(M_PI);
+    const float center = static_cast<float>(num_taps / 2);
+    for (size_t phase = 0; phase <= num_phases; ++phase) {
+      float* h = &table[phase * num_taps];
+      float t = static_cast<float>(phase) / static_cast<float>(num_phases);
+      float sum = 0.0f;
+      for (size_t i = 0; i < num_taps; ++i) {
+        float x = static_cast<float>(i) - center + t;
+        float sinc = x == 0.0f ? 1.0f : sinf(pi * cutoff * x) / (pi * x);
+        // Blackman window over [-center, center].
+        float w = x / center;
+        float window = w <= -1.0f || w >= 1.0f
+            ? 0.0f
+            : 0.42f + 0.5f * cosf(pi * w) + 0.08f * cosf(2.0f * pi * w);
+        h[i] = sinc * window;
+        sum += h[i];
+      }
+      // Unity gain at DC for all phases.
+      for (size_t i = 0; i < num_taps; ++i) {
+        h[i] /= sum;
+      }
+    }
+  }
+  
+  void Init(const float* table) {
+    h_ = table;
+    set_ratio(1.0f);
+    Reset();
+  }
+  
+  void Reset() {
+    std::fill(&history_[0], &history_[2 * num_taps], 0.0f);
+    history_ptr_ = 0;
+    position_ = 0.0f;
+  }
+  
+  // Number of input samples per output sample. Clamped to 1 / 256 (this
+  // also catches 0, negative values and NaN, for which Process would never
+  // return).
+  inline void set_ratio(float ratio) {
+    const float min_ratio = 1.0f / 256.0f;
+    ratio_ = ratio > min_ratio ? ratio : min_ratio;
+  }
+  
+  // Latency, in input samples.
+  inline int32_t delay() const { return num_taps / 2; }
+  
+  // Returns the number of samples written to out, which must have room for
+  // input_size / ratio + 1 samples.
+  inline size_t Process(const float* in, float* out, size_t input_size) {
+    float* out_start = out;
+    float position = position_;
+    const float ratio = ratio_;
+    const float scale = static_cast<float>(num_phases);
+    
+    while (input_size--) {
+      // The history is stored twice, newest sample first, so that the last
+      // num_taps samples can always be read contiguously.
+      history_ptr_ = history_ptr_ == 0 ? num_taps - 1 : history_ptr_ - 1;
+      history_[history_ptr_] = history_[history_ptr_ + num_taps] = *in++;
+      const float* x = &history_[history_ptr_];
+      
+      while (position < 1.0f) {
+        float phase = position * scale;
+        size_t phase_integral = static_cast<size_t>(phase);
+        float phase_fractional = phase - static_cast<float>(phase_integral);
+        const float* h = &h_[phase_integral * num_taps];
+        float a = Dot(h, x);
+        float b = Dot(h + num_taps, x);
+        *out++ = a + (b - a) * phase_fractional;
+        position += ratio;
+      }
+      position -= 1.0f;
+    }
+    position_ = position;
+    return out - out_start;
+  }
+  
+ private:
+  STATIC_ASSERT(num_taps % 2 == 0, even_number_of_taps);
+  
+  static inline float Dot(const float* h, const float* x) {
+#ifdef __SSE__
+    if (num_taps % 4 == 0) {
+      __m128 sum = _mm_setzero_ps();
+      for (size_t i = 0; i < num_taps; i += 4) {
+        sum = _mm_add_ps(
+            sum,
+            _mm_mul_ps(_mm_loadu_ps(&h[i]), _mm_loadu_ps(&x[i])));
+      }
+      sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+      sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+      return _mm_cvtss_f32(sum);
+    }
+#endif  // __SSE__
+    float sum = 0.0f;
+    for (size_t i = 0; i < num_taps; ++i) {
+      sum += h[i] * x[i];
+    }
+    return sum;
+  }
+  
+  const float* h_;
+  float history_[2 * num_taps];
+  size_t history_ptr_;
+  float position_;
+  float ratio_;
+  
+  DISALLOW_COPY_AND_ASSIGN(Resampler);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_RESAMPLER_H_
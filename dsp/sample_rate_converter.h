@@ -33,6 +33,14 @@
 
 #include <algorithm>
 
+#if __cplusplus >= 201103L
+#include "stmlib/dsp/fir_design.h"
+#endif  // __cplusplus >= 201103L
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif  // __SSE__
+
 namespace stmlib {
 
 enum SampleRateConversionDirection {
@@ -40,8 +48,20 @@ enum SampleRateConversionDirection {
   SRC_DOWN
 };
 
+// Filter coefficients. Unless the application provides a specialization
+// (for example a table generated by an external script), a Kaiser-windowed
+// sinc with 80dB of stopband attenuation is designed at compile time. For
+// other attenuations, specialize SRC_FIR by inheriting from KaiserLowPassFIR.
+// The design requires C++11: older compilers only get the specializations
+// provided by the application.
+#if __cplusplus >= 201103L
+template <SampleRateConversionDirection direction, int32_t ratio, int32_t length>
+struct SRC_FIR : public KaiserLowPassFIR<
+    ratio, length, 80, direction == SRC_UP ? ratio : 1> { };
+#else
 template <SampleRateConversionDirection direction, int32_t ratio, int32_t length>
 struct SRC_FIR { };
+#endif  // __cplusplus >= 201103L
 
 template<int32_t N>
 struct FilterState {
@@ -225,7 +245,12 @@ class SampleRateConverter<SRC_DOWN, ratio, filter_size> {
  private:
   enum {
     N = filter_size,
-    K = ratio
+    K = ratio,
+    // Input samples accumulated in the linear buffer, after the history,
+    // before it is compacted. The buffer takes 2N samples, as the circular
+    // buffer it replaces.
+    BLOCK_SIZE = N + 1 > ratio ? N + 1 : ratio,
+    BUFFER_SIZE = N - 1 + BLOCK_SIZE
   };
  
  public:
@@ -233,76 +258,380 @@ class SampleRateConverter<SRC_DOWN, ratio, filter_size> {
   ~SampleRateConverter() { }
 
   inline void Init() {
-    std::fill(&x_[0], &x_[2 * N], 0);
-    x_ptr_ = &x_[N - 1];
+    std::fill(&x_[0], &x_[BUFFER_SIZE], 0);
+    size_ = N - 1;
+    next_ = N - 1 + ratio - 1;
   };
 
   inline int32_t delay() const { return filter_size / 2; }
 
+  // Accepts any number of input samples. An output sample is computed at the
+  // last sample of each group of "ratio" input samples, and the samples which
+  // do not complete a group are kept for the next call. Returns the number of
+  // output samples written.
+  inline size_t Process(const float* in, float* out, size_t input_size) {
+    SRC_FIR<SRC_DOWN, ratio, filter_size> ir;
+    float* out_start = out;
+    while (input_size) {
+      size_t n = std::min(input_size, static_cast<size_t>(BUFFER_SIZE) - size_);
+      std::copy(&in[0], &in[n], &x_[size_]);
+      size_ += n;
+      in += n;
+      input_size -= n;
+      
+      // The buffer is linear, so the filter always reads contiguous samples.
+      while (next_ < size_) {
+        Accumulator<N, -1, 1, filter_size> accumulator;
+        *out++ = accumulator(&x_[next_], ir);
+        next_ += ratio;
+      }
+      
+      // Move the history needed by the next outputs to the beginning of
+      // the buffer.
+      if (size_ == BUFFER_SIZE) {
+        size_t start = size_ - (N - 1);
+        std::copy(&x_[start], &x_[size_], &x_[0]);
+        size_ -= start;
+        next_ -= start;
+      }
+    }
+    return out - out_start;
+  }
+ 
+ private:
+  float x_[BUFFER_SIZE];
+  size_t size_;
+  size_t next_;
+
+  DISALLOW_COPY_AND_ASSIGN(SampleRateConverter);
+};
+
+// Multichannel converters work on interleaved frames of num_channels
+// samples. Each coefficient is read once and applied to all the channels of
+// a frame (in SSE registers on the host).
+template<int32_t num_channels>
+struct FrameMultiplyAccumulate {
+  static inline void Process(float* acc, const float* x, float h) {
+    int32_t c = 0;
+#ifdef __SSE__
+    const __m128 h_4 = _mm_set1_ps(h);
+    for (; c + 4 <= num_channels; c += 4) {
+      _mm_storeu_ps(
+          &acc[c],
+          _mm_add_ps(
+              _mm_loadu_ps(&acc[c]),
+              _mm_mul_ps(_mm_loadu_ps(&x[c]), h_4)));
+    }
+#endif  // __SSE__
+    for (; c < num_channels; ++c) {
+      acc[c] += x[c] * h;
+    }
+  }
+};
+
+template<
+    int32_t num_channels,
+    int32_t N,
+    int32_t x_stride,
+    int32_t h_stride,
+    int32_t mirror = 0,
+    int32_t i = 0,
+    int32_t h_offset = 0>
+struct MultiChannelAccumulator {
+  enum {
+    h_index = mirror != 0 && h_offset + i * h_stride >= mirror / 2 ?
+        mirror - 1 - i * h_stride - h_offset : h_offset + i * h_stride
+  };
+  
+  template<typename IR>
+  inline void operator()(const float* x, const IR& h, float* acc) const {
+    FrameMultiplyAccumulate<num_channels>::Process(
+        acc, &x[i * x_stride * num_channels], h.template Read<h_index>());
+    MultiChannelAccumulator<
+        num_channels, N - 1, x_stride, h_stride, mirror, i + 1, h_offset> a;
+    a(x, h, acc);
+  }
+};
+
+template<
+    int32_t num_channels,
+    int32_t x_stride,
+    int32_t h_stride,
+    int32_t mirror,
+    int32_t i,
+    int32_t h_offset>
+struct MultiChannelAccumulator<
+    num_channels, 0, x_stride, h_stride, mirror, i, h_offset> {
+  template<typename IR>
+  inline void operator()(const float* x, const IR& h, float* acc) const { }
+};
+
+template<
+    SampleRateConversionDirection direction,
+    int32_t ratio,
+    int32_t filter_size,
+    int32_t num_channels>
+class MultiChannelSampleRateConverter { };
+
+template<int32_t ratio, int32_t filter_size, int32_t num_channels>
+class MultiChannelSampleRateConverter<
+    SRC_UP, ratio, filter_size, num_channels> {
+ private:
+  enum {
+    N = filter_size / ratio,
+    K = ratio
+  };
+  
+ public:
+  MultiChannelSampleRateConverter() { }
+  ~MultiChannelSampleRateConverter() { }
+  
+  inline void Init() {
+    std::fill(&x_[0], &x_[2 * N * num_channels], 0);
+    x_ptr_ = 0;
+  }
+  
+  inline int32_t delay() const { return filter_size / ratio / 2; }
+  
+  // Reads input_size frames, writes ratio * input_size frames.
   inline void Process(const float* in, float* out, size_t input_size) {
-    // When downsampling, the number of input samples must be a multiple
-    // of the downsampling ratio.
-    if ((input_size % ratio) != 0) {
-      return;
+    SRC_FIR<SRC_UP, ratio, filter_size> ir;
+    while (input_size--) {
+      // The history is stored twice, newest frame first, so that the last N
+      // frames can always be read contiguously.
+      x_ptr_ = x_ptr_ == 0 ? N - 1 : x_ptr_ - 1;
+      std::copy(&in[0], &in[num_channels], &x_[x_ptr_ * num_channels]);
+      std::copy(&in[0], &in[num_channels], &x_[(x_ptr_ + N) * num_channels]);
+      in += num_channels;
+      RenderPhases<K>(&x_[x_ptr_ * num_channels], ir, &out);
     }
+  }
+  
+ private:
+  template<int32_t remaining>
+  struct Phase { };
+  
+  template<int32_t remaining, typename IR>
+  inline void RenderPhases(const float* x, const IR& ir, float** out) {
+    RenderPhases(x, ir, out, Phase<remaining>());
+  }
+  
+  template<int32_t remaining, typename IR>
+  inline void RenderPhases(
+      const float* x, const IR& ir, float** out, Phase<remaining>) {
+    float acc[num_channels];
+    std::fill(&acc[0], &acc[num_channels], 0.0f);
+    MultiChannelAccumulator<
+        num_channels, N, 1, K, filter_size, 0, K - remaining> a;
+    a(x, ir, acc);
+    std::copy(&acc[0], &acc[num_channels], *out);
+    *out += num_channels;
+    RenderPhases(x, ir, out, Phase<remaining - 1>());
+  }
+  
+  template<typename IR>
+  inline void RenderPhases(const float* x, const IR& ir, float** out, Phase<0>) {
+  }
+  
+  float x_[2 * N * num_channels];
+  size_t x_ptr_;
+  
+  DISALLOW_COPY_AND_ASSIGN(MultiChannelSampleRateConverter);
+};
 
+template<int32_t ratio, int32_t filter_size, int32_t num_channels>
+class MultiChannelSampleRateConverter<
+    SRC_DOWN, ratio, filter_size, num_channels> {
+ private:
+  enum {
+    N = filter_size,
+    BLOCK_SIZE = N + 1 > ratio ? N + 1 : ratio,
+    BUFFER_SIZE = N - 1 + BLOCK_SIZE
+  };
+  
+ public:
+  MultiChannelSampleRateConverter() { }
+  ~MultiChannelSampleRateConverter() { }
+  
+  inline void Init() {
+    std::fill(&x_[0], &x_[BUFFER_SIZE * num_channels], 0);
+    size_ = N - 1;
+    next_ = N - 1 + ratio - 1;
+  }
+  
+  inline int32_t delay() const { return filter_size / 2; }
+  
+  // Same buffering as SampleRateConverter<SRC_DOWN>, with sizes in frames.
+  inline size_t Process(const float* in, float* out, size_t input_size) {
     SRC_FIR<SRC_DOWN, ratio, filter_size> ir;
-    if (input_size >= 8 * filter_size) {
-      std::copy(&in[0], &in[N], &x_[N - 1]);
+    float* out_start = out;
+    while (input_size) {
+      size_t n = std::min(input_size, static_cast<size_t>(BUFFER_SIZE) - size_);
+      std::copy(
+          &in[0], &in[n * num_channels], &x_[size_ * num_channels]);
+      size_ += n;
+      in += n * num_channels;
+      input_size -= n;
       
-      // Generate the samples which require access to the history buffer.
-      for (int32_t i = 0; i < N; i += ratio) {
-        Accumulator<N, -1, 1, filter_size> accumulator;
-        *out++ = accumulator(&x_[N - 1 + i], ir);
-        in += ratio;
-        input_size -= ratio;
+      while (next_ < size_) {
+        float acc[num_channels];
+        std::fill(&acc[0], &acc[num_channels], 0.0f);
+        MultiChannelAccumulator<num_channels, N, -1, 1, filter_size> a;
+        a(&x_[next_ * num_channels], ir, acc);
+        std::copy(&acc[0], &acc[num_channels], out);
+        out += num_channels;
+        next_ += ratio;
       }
-        
-      // From now on, all the samples we need to access are located inside
-      // the input buffer passed as an argument, and since the filter
-      // is small, we can unroll the summation loop.
-      if ((input_size / ratio) & 1) {
-        while (input_size) {
-          Accumulator<N, -1, 1, filter_size> accumulator;
-          *out++ = accumulator(in, ir);
-          input_size -= ratio;
-          in += ratio;
-        }
-      } else {
-        while (input_size) {
-          Accumulator<N, -1, 1, filter_size> accumulator;
-          *out++ = accumulator(in, ir);
-          *out++ = accumulator(in + ratio, ir);
-          input_size -= 2 * ratio;
-          in += 2 * ratio;
-        }
+      
+      if (size_ == BUFFER_SIZE) {
+        size_t start = size_ - (N - 1);
+        std::copy(
+            &x_[start * num_channels],
+            &x_[size_ * num_channels],
+            &x_[0]);
+        size_ -= start;
+        next_ -= start;
       }
+    }
+    return (out - out_start) / num_channels;
+  }
+  
+ private:
+  float x_[BUFFER_SIZE * num_channels];
+  size_t size_;
+  size_t next_;
+  
+  DISALLOW_COPY_AND_ASSIGN(MultiChannelSampleRateConverter);
+};
 
-      // Copy last input samples to history buffer.
-      std::copy(&in[-N + 1], &in[0], &x_[0]);
-    } else {
-      // Variant which uses a circular buffer to store history.
-      while (input_size) {
-        for (int32_t i = 0; i < ratio; ++i) {
-          x_ptr_[0] = x_ptr_[N] = *in++;
-          --x_ptr_;
-          if (x_ptr_ < x_) {
-            x_ptr_ += N;
-          }
-        }
-        input_size -= ratio;
-
-        Accumulator<N, 1, 1, filter_size> accumulator;
-        *out++ = accumulator(&x_ptr_[1], ir);
-      }
+// Half-band filters for conversion by a factor of 2. The filter has
+// num_taps = 4 * M - 1 taps: a center tap of 0.5, and M distinct coefficients
+// at odd distances from the center (all the taps at even distances are
+// zero). SRC_HALF_BAND_FIR<num_taps>::Read<k>() returns the coefficient at
+// distance 2k + 1 from the center. Zero taps are skipped and symmetric taps
+// are summed before multiplication, so each output sample costs M
+// multiplications instead of num_taps. Cascade two (three) converters for
+// 4x (8x) conversion. As for SRC_FIR, the default Kaiser design requires
+// C++11.
+#if __cplusplus >= 201103L
+template<int32_t num_taps>
+struct SRC_HALF_BAND_FIR : public KaiserHalfBandFIR<num_taps, 80> { };
+#else
+template<int32_t num_taps>
+struct SRC_HALF_BAND_FIR { };
+#endif  // __cplusplus >= 201103L
+
+template<int32_t M, int32_t stride, int32_t k = 0>
+struct HalfBandAccumulator {
+  template<typename IR>
+  inline float operator()(const float* a, const float* b, const IR& h) const {
+    HalfBandAccumulator<M - 1, stride, k + 1> next;
+    return (a[k * stride] + b[-k * stride]) * h.template Read<k>() + \
+        next(a, b, h);
+  }
+};
+
+template<int32_t stride, int32_t k>
+struct HalfBandAccumulator<0, stride, k> {
+  template<typename IR>
+  inline float operator()(const float* a, const float* b, const IR& h) const {
+    return 0.0f;
+  }
+};
+
+template<SampleRateConversionDirection direction, int32_t num_taps>
+class HalfBandSampleRateConverter { };
+
+template<int32_t num_taps>
+class HalfBandSampleRateConverter<SRC_UP, num_taps> {
+ private:
+  enum {
+    M = (num_taps + 1) / 4,
+    HISTORY_SIZE = 2 * M
+  };
+  
+ public:
+  HalfBandSampleRateConverter() { }
+  ~HalfBandSampleRateConverter() { }
+  
+  inline void Init() {
+    std::fill(&x_[0], &x_[2 * HISTORY_SIZE], 0);
+    x_ptr_ = 0;
+  }
+  
+  inline int32_t delay() const { return num_taps / 4; }
+  
+  // Writes 2 * input_size samples.
+  inline void Process(const float* in, float* out, size_t input_size) {
+    SRC_HALF_BAND_FIR<num_taps> ir;
+    while (input_size--) {
+      // History stored twice, newest sample first, to be read contiguously.
+      x_ptr_ = x_ptr_ == 0 ? HISTORY_SIZE - 1 : x_ptr_ - 1;
+      x_[x_ptr_] = x_[x_ptr_ + HISTORY_SIZE] = *in++;
+      const float* x = &x_[x_ptr_];
+      
+      HalfBandAccumulator<M, 1> accumulator;
+      *out++ = 2.0f * accumulator(&x[M], &x[M - 1], ir);
+      *out++ = x[M - 1];
     }
   }
- 
+  
  private:
-  float x_[2 * N];
-  float* x_ptr_;
+  STATIC_ASSERT(num_taps % 4 == 3, invalid_half_band_length);
+  
+  float x_[2 * HISTORY_SIZE];
+  size_t x_ptr_;
+  
+  DISALLOW_COPY_AND_ASSIGN(HalfBandSampleRateConverter);
+};
 
-  DISALLOW_COPY_AND_ASSIGN(SampleRateConverter);
+template<int32_t num_taps>
+class HalfBandSampleRateConverter<SRC_DOWN, num_taps> {
+ private:
+  enum {
+    M = (num_taps + 1) / 4,
+    CENTER = num_taps / 2
+  };
+  
+ public:
+  HalfBandSampleRateConverter() { }
+  ~HalfBandSampleRateConverter() { }
+  
+  inline void Init() {
+    std::fill(&x_[0], &x_[2 * num_taps], 0);
+    x_ptr_ = 0;
+    odd_ = false;
+  }
+  
+  inline int32_t delay() const { return num_taps / 2; }
+  
+  // Accepts any number of input samples, returns the number of output
+  // samples written.
+  inline size_t Process(const float* in, float* out, size_t input_size) {
+    SRC_HALF_BAND_FIR<num_taps> ir;
+    float* out_start = out;
+    while (input_size--) {
+      x_ptr_ = x_ptr_ == 0 ? num_taps - 1 : x_ptr_ - 1;
+      x_[x_ptr_] = x_[x_ptr_ + num_taps] = *in++;
+      odd_ = !odd_;
+      if (!odd_) {
+        const float* x = &x_[x_ptr_];
+        HalfBandAccumulator<M, 2> accumulator;
+        *out++ = 0.5f * x[CENTER] + \
+            accumulator(&x[CENTER + 1], &x[CENTER - 1], ir);
+      }
+    }
+    return out - out_start;
+  }
+  
+ private:
+  STATIC_ASSERT(num_taps % 4 == 3, invalid_half_band_length);
+  
+  float x_[2 * num_taps];
+  size_t x_ptr_;
+  bool odd_;
+  
+  DISALLOW_COPY_AND_ASSIGN(HalfBandSampleRateConverter);
 };
 
 }  // namespace stmlib
@@ -0,0 +1,241 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Uniformly partitioned overlap-save convolution, for long impulse responses
+// (cabinets, reverbs). The impulse response is split into partitions of
+// block_size samples whose spectra are stored along with a frequency domain
+// delay line of the spectra of the past input blocks. Each block of input
+// costs one direct and one inverse FFT of 2 * block_size points, and one
+// complex multiply-accumulate per partition. The latency is block_size
+// samples: smaller blocks trade CPU for latency.
+
+#ifndef STMLIB_FFT_PARTITIONED_CONVOLVER_H_
+#define STMLIB_FFT_PARTITIONED_CONVOLVER_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif  // __SSE__
+
+#include "stmlib/fft/shy_fft.h"
+#include "stmlib/utils/buffer_allocator.h"
+
+namespace stmlib {
+
+// acc += a * b, for spectra of size points in the ShyFFT layout (real parts
+// of bins 0 to size / 2, then imaginary parts of bins 1 to size / 2 - 1).
+inline void SpectrumMultiplyAccumulate(
+    const float* a,
+    const float* b,
+    float* acc,
+    size_t size) {
+  const size_t half = size >> 1;
+  acc[0] += a[0] * b[0];
+  acc[half] += a[half] * b[half];
+  
+  const float* a_r = a;
+  const float* a_i = a + half;
+  const float* b_r = b;
+  const float* b_i = b + half;
+  float* acc_r = acc;
+  float* acc_i = acc + half;
+  size_t k = 1;
+#ifdef __SSE__
+  for (; k + 4 <= half; k += 4) {
+    __m128 ar = _mm_loadu_ps(&a_r[k]);
+    __m128 ai = _mm_loadu_ps(&a_i[k]);
+    __m128 br = _mm_loadu_ps(&b_r[k]);
+    __m128 bi = _mm_loadu_ps(&b_i[k]);
+    _mm_storeu_ps(&acc_r[k], _mm_add_ps(
+        _mm_loadu_ps(&acc_r[k]),
+        _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi))));
+    _mm_storeu_ps(&acc_i[k], _mm_add_ps(
+        _mm_loadu_ps(&acc_i[k]),
+        _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br))));
+  }
+#endif  // __SSE__
+  for (; k < half; ++k) {
+    acc_r[k] += a_r[k] * b_r[k] - a_i[k] * b_i[k];
+    acc_i[k] += a_r[k] * b_i[k] + a_i[k] * b_r[k];
+  }
+}
+
+template<size_t block_size>
+class PartitionedConvolver {
+ public:
+  typedef ShyFFT<float, 2 * block_size> FFT;
+  
+  enum {
+    fft_size = 2 * block_size,
+    latency = block_size
+  };
+  
+  PartitionedConvolver() { }
+  ~PartitionedConvolver() { }
+  
+  static inline size_t num_partitions(size_t ir_size) {
+    return (ir_size + block_size - 1) / block_size;
+  }
+  
+  // Size of the buffer (in floats) for impulse responses of up to
+  // max_ir_size samples: the impulse response spectra and the delay line
+  // (fft_size per partition each), plus the input history, accumulator,
+  // workspace and output block.
+  static inline size_t buffer_size(size_t max_ir_size) {
+    return 2 * num_partitions(max_ir_size) * fft_size +
+        3 * fft_size + block_size;
+  }
+  
+  // The FFT is initialized by the caller, and can be shared by several
+  // instances.
+  bool Init(FFT* fft, BufferAllocator* allocator, size_t max_ir_size) {
+    return Init(
+        fft,
+        allocator->Allocate<float>(buffer_size(max_ir_size)),
+        max_ir_size);
+  }
+  
+  bool Init(FFT* fft, float* buffer, size_t max_ir_size) {
+    if (!buffer) {
+      return false;
+    }
+    fft_ = fft;
+    max_num_partitions_ = num_partitions(max_ir_size);
+    ir_ = buffer;
+    delay_line_ = ir_ + max_num_partitions_ * fft_size;
+    history_ = delay_line_ + max_num_partitions_ * fft_size;
+    accumulator_ = history_ + fft_size;
+    workspace_ = accumulator_ + fft_size;
+    output_ = workspace_ + fft_size;
+    num_partitions_ = 0;
+    Reset();
+    return true;
+  }
+  
+  void Reset() {
+    std::fill(
+        &delay_line_[0],
+        &delay_line_[max_num_partitions_ * fft_size],
+        0.0f);
+    std::fill(&history_[0], &history_[fft_size], 0.0f);
+    std::fill(&output_[0], &output_[block_size], 0.0f);
+    delay_line_ptr_ = 0;
+    fill_ = 0;
+  }
+  
+  // Computes the spectra of the partitions. Not meant to be called from the
+  // audio callback: it costs one FFT per partition. Impulse responses
+  // longer than max_ir_size are truncated.
+  void set_impulse_response(const float* ir, size_t size) {
+    num_partitions_ = std::min(num_partitions(size), max_num_partitions_);
+    size = std::min(size, num_partitions_ * block_size);
+    // The 1 / fft_size normalization of the inverse FFT is done here.
+    const float scale = 1.0f / fft_size;
+    for (size_t p = 0; p < num_partitions_; ++p) {
+      size_t n = std::min(static_cast<size_t>(block_size), size);
+      for (size_t i = 0; i < n; ++i) {
+        workspace_[i] = ir[i] * scale;
+      }
+      std::fill(&workspace_[n], &workspace_[fft_size], 0.0f);
+      fft_->Direct(workspace_, &ir_[p * fft_size]);
+      ir += n;
+      size -= n;
+    }
+    Reset();
+  }
+  
+  // Input blocks can have any size. Can be used in place.
+  void Process(const float* in, float* out, size_t size) {
+    while (size) {
+      size_t n = std::min(size, block_size - fill_);
+      std::copy(&in[0], &in[n], &history_[block_size + fill_]);
+      std::copy(&output_[fill_], &output_[fill_ + n], &out[0]);
+      in += n;
+      out += n;
+      size -= n;
+      fill_ += n;
+      if (fill_ == block_size) {
+        ProcessBlock();
+        fill_ = 0;
+      }
+    }
+  }
+  
+ private:
+  void ProcessBlock() {
+    if (!num_partitions_) {
+      std::fill(&output_[0], &output_[block_size], 0.0f);
+      return;
+    }
+    
+    // The spectrum of the last 2 blocks of input enters the delay line.
+    delay_line_ptr_ = delay_line_ptr_ == 0
+        ? num_partitions_ - 1
+        : delay_line_ptr_ - 1;
+    std::copy(&history_[0], &history_[fft_size], &workspace_[0]);
+    std::copy(&history_[block_size], &history_[fft_size], &history_[0]);
+    fft_->Direct(workspace_, &delay_line_[delay_line_ptr_ * fft_size]);
+    
+    std::fill(&accumulator_[0], &accumulator_[fft_size], 0.0f);
+    size_t d = delay_line_ptr_;
+    for (size_t p = 0; p < num_partitions_; ++p) {
+      SpectrumMultiplyAccumulate(
+          &delay_line_[d * fft_size],
+          &ir_[p * fft_size],
+          accumulator_,
+          fft_size);
+      d = d == num_partitions_ - 1 ? 0 : d + 1;
+    }
+    
+    // Overlap-save: only the second half of the result is free from
+    // circular aliasing.
+    fft_->Inverse(accumulator_, workspace_);
+    std::copy(&workspace_[block_size], &workspace_[fft_size], &output_[0]);
+  }
+  
+  FFT* fft_;
+  
+  float* ir_;
+  float* delay_line_;
+  float* history_;
+  float* accumulator_;
+  float* workspace_;
+  float* output_;
+  
+  size_t max_num_partitions_;
+  size_t num_partitions_;
+  size_t delay_line_ptr_;
+  size_t fill_;
+  
+  DISALLOW_COPY_AND_ASSIGN(PartitionedConvolver);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_FFT_PARTITIONED_CONVOLVER_H_
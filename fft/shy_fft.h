@@ -30,7 +30,14 @@
 // Improvements:
 // * No dynamic allocations.
 // * No additional buffering (can use the input buffer as a workspace).
-// * No big bitrev lookup table.
+// * No big bitrev lookup table. Above 256 points, the samples are reordered
+//   with a bit-reversed counter, so any power-of-two size is supported.
+// * The tables are shared by all the instances of a given size, and filled
+//   by Init(). Define SHY_FFT_CONSTANT_TABLES to compute them at compile time
+//   instead (constant data, and Init() is free). This requires C++11 - the
+//   switch is ignored otherwise - and the compile time grows with the size of
+//   the transform (about 5s per translation unit for 65536 points on a
+//   desktop machine), so it is best kept for small sizes.
 // * Keep the fixed size template signature, but also provide method for
 //   variable size (up to the fixed size).
 
@@ -42,6 +49,17 @@
 #include <algorithm>
 #include <cmath>
 
+#if defined(SHY_FFT_CONSTANT_TABLES) && __cplusplus < 201103L
+#undef SHY_FFT_CONSTANT_TABLES
+#endif  // SHY_FFT_CONSTANT_TABLES && __cplusplus < 201103L
+
+#ifdef SHY_FFT_CONSTANT_TABLES
+#include "stmlib/dsp/fir_design.h"
+#define SHY_FFT_CONSTEXPR constexpr
+#else
+#define SHY_FFT_CONSTEXPR inline
+#endif  // SHY_FFT_CONSTANT_TABLES
+
 namespace stmlib {
 
 // Compile-time log 2
@@ -67,6 +85,113 @@ template<> struct BitReversalLut<7> { enum { size = 32 }; };
 template<> struct BitReversalLut<8> { enum { size = 64 }; };
 
 
+// Increments a counter stored with its bits in reverse order (msb is the
+// weight of the reversed counter's least significant bit). Runs in constant
+// amortized time, so that transforms larger than the lookup tables can be
+// reordered without any additional memory.
+inline size_t BitReversedIncrement(size_t r, size_t msb) {
+  while (r & msb) {
+    r ^= msb;
+    msb >>= 1;
+  }
+  return r | msb;
+}
+
+
+// Tables of size entries, with entry i given by Generator::Entry(i). Init()
+// must be called before reading the values (see SHY_FFT_CONSTANT_TABLES).
+#ifdef SHY_FFT_CONSTANT_TABLES
+
+// Compile-time tables. The entries are generated by expanding a sequence of
+// indices, built by halves to keep the template recursion shallow.
+template<size_t... i>
+struct IndexSequence { };
+
+template<typename A, typename B>
+struct ConcatenateIndices;
+
+template<size_t... a, size_t... b>
+struct ConcatenateIndices<IndexSequence<a...>, IndexSequence<b...> > {
+  typedef IndexSequence<a..., (sizeof...(a) + b)...> type;
+};
+
+template<size_t n>
+struct MakeIndexSequence {
+  typedef typename ConcatenateIndices<
+      typename MakeIndexSequence<n / 2>::type,
+      typename MakeIndexSequence<n - n / 2>::type>::type type;
+};
+
+template<> struct MakeIndexSequence<0> { typedef IndexSequence<> type; };
+template<> struct MakeIndexSequence<1> { typedef IndexSequence<0> type; };
+
+template<
+    typename T,
+    typename Generator,
+    size_t size,
+    typename Indices = typename MakeIndexSequence<size>::type>
+struct ConstantTable;
+
+template<typename T, typename Generator, size_t size, size_t... i>
+struct ConstantTable<T, Generator, size, IndexSequence<i...> > {
+  static void Init() { }
+  static constexpr T values[size] = { Generator::Entry(i)... };
+};
+
+template<typename T, typename Generator, size_t size, size_t... i>
+constexpr T ConstantTable<
+    T, Generator, size, IndexSequence<i...> >::values[size];
+
+struct TableMath {
+  static constexpr double pi() { return FirDesign::kPi; }
+  static constexpr double sin(double x) { return FirDesign::Sin(x); }
+};
+
+#else
+
+// Tables filled at run time, shared by all the instances of a given size.
+template<typename T, typename Generator, size_t size>
+struct ConstantTable {
+  static void Init() {
+    for (size_t i = 0; i < size; ++i) {
+      values[i] = Generator::Entry(i);
+    }
+  }
+  static T values[size];
+};
+
+template<typename T, typename Generator, size_t size>
+T ConstantTable<T, Generator, size>::values[size];
+
+struct TableMath {
+  static inline double pi() { return 3.141592653589793; }
+  static inline double sin(double x) { return std::sin(x); }
+};
+
+#endif  // SHY_FFT_CONSTANT_TABLES
+
+
+// Table used by the first two passes, for sizes up to 256: the reversed bits
+// of 4 * i, among num_passes bits.
+template<size_t num_passes>
+struct BitReversalGenerator {
+  static SHY_FFT_CONSTEXPR uint8_t Reverse(
+      uint8_t source, uint8_t destination, uint8_t byte) {
+    return source == 0 ? byte : Reverse(
+        source >> 1,
+        destination >> 1,
+        source & 1 ? byte | destination : byte);
+  }
+  
+  static SHY_FFT_CONSTEXPR uint8_t Entry(size_t i) {
+    return Reverse(
+        static_cast<uint8_t>(i << 2),
+        static_cast<uint8_t>((1 << num_passes) >> 1),
+        0);
+  }
+};
+
+
 // Typed math functions and constants.
 template<typename T>
 struct Math {
@@ -74,6 +199,7 @@ struct Math {
   inline T sqrt_2_div_2() const;
   inline T cos(T x);
   inline T sin(T x);
+  static SHY_FFT_CONSTEXPR T twiddle(double x);  // From a value in [-1, 1].
 };
 
 template<>
@@ -82,6 +208,9 @@ struct Math<float> {
   inline float sqrt_2_div_2() const { return 0.7071067811865476f; }
   inline float cos(float x) { return cosf(x); }
   inline float sin(float x) { return sinf(x); }
+  static SHY_FFT_CONSTEXPR float twiddle(double x) {
+    return static_cast<float>(x);
+  }
 };
 
 template<>
@@ -90,10 +219,108 @@ struct Math<double> {
   inline float sqrt_2_div_2() const { return 0.7071067811865476; }
   inline double cos(double x) { return std::cos(x); }
   inline double sin(double x) { return std::sin(x); }
+  static SHY_FFT_CONSTEXPR double twiddle(double x) { return x; }
 };
 
+// Fixed point samples (see FixedPointShyFFT): Q15 and Q31, with twiddle
+// factors in the same format. Products are computed with Product.
+template<>
+struct Math<int16_t> {
+  typedef int32_t Product;
+  enum { fractional_bits = 15 };
+  inline int16_t sqrt_2_div_2() const { return 23170; }
+  static SHY_FFT_CONSTEXPR int16_t twiddle(double x) {
+    return x * 32768.0 >= 32767.0 ? 32767 : static_cast<int16_t>(
+        x * 32768.0 + (x >= 0.0 ? 0.5 : -0.5));
+  }
+};
+
+template<>
+struct Math<int32_t> {
+  typedef int64_t Product;
+  enum { fractional_bits = 31 };
+  inline int32_t sqrt_2_div_2() const { return 1518500250; }
+  static SHY_FFT_CONSTEXPR int32_t twiddle(double x) {
+    return x * 2147483648.0 >= 2147483647.0 ? 2147483647 : static_cast<int32_t>(
+        x * 2147483648.0 + (x >= 0.0 ? 0.5 : -0.5));
+  }
+};
+
+
+// K values processed in lockstep. Used as the sample type of the transforms
+// to run K transforms of the same size in one pass (see ShyFFT::DirectBatch).
+// The loops have a fixed trip count and are vectorized by the compiler.
+template<typename T, size_t K>
+struct Lanes {
+  Lanes() { }
+  Lanes(T x) { std::fill(&v[0], &v[K], x); }
+  T v[K];
+};
+
+template<typename T, size_t K>
+inline Lanes<T, K> operator+(const Lanes<T, K>& a, const Lanes<T, K>& b) {
+  Lanes<T, K> r;
+  for (size_t k = 0; k < K; ++k) {
+    r.v[k] = a.v[k] + b.v[k];
+  }
+  return r;
+}
+
+template<typename T, size_t K>
+inline Lanes<T, K> operator-(const Lanes<T, K>& a, const Lanes<T, K>& b) {
+  Lanes<T, K> r;
+  for (size_t k = 0; k < K; ++k) {
+    r.v[k] = a.v[k] - b.v[k];
+  }
+  return r;
+}
+
+template<typename T, size_t K>
+inline Lanes<T, K> operator*(const Lanes<T, K>& a, const Lanes<T, K>& b) {
+  Lanes<T, K> r;
+  for (size_t k = 0; k < K; ++k) {
+    r.v[k] = a.v[k] * b.v[k];
+  }
+  return r;
+}
+
+template<typename T, size_t K>
+inline Lanes<T, K> operator*(const Lanes<T, K>& a, T b) {
+  Lanes<T, K> r;
+  for (size_t k = 0; k < K; ++k) {
+    r.v[k] = a.v[k] * b;
+  }
+  return r;
+}
+
+template<typename T, size_t K>
+struct Math<Lanes<T, K> > {
+  inline T sqrt_2_div_2() const { return Math<T>().sqrt_2_div_2(); }
+};
+
+
+// Look-up table for trigonometric data. For each pass, from 3, pass_size =
+// 2^(pass - 1) entries cos(pi * i / (2 * pass_size)), starting at
+// pass_size - 4.
+template<typename T>
+struct TrigLutGenerator {
+  static SHY_FFT_CONSTEXPR size_t PassSize(size_t index, size_t pass_size) {
+    return index + 4 < 2 * pass_size
+        ? pass_size
+        : PassSize(index, 2 * pass_size);
+  }
+  
+  static SHY_FFT_CONSTEXPR T Entry(size_t index, size_t pass_size) {
+    // cos(x) = sin(pi / 2 + x).
+    return Math<T>::twiddle(TableMath::sin(TableMath::pi() * (
+        0.5 + double(index + 4 - pass_size) / (2 * pass_size))));
+  }
+  
+  static SHY_FFT_CONSTEXPR T Entry(size_t index) {
+    return Entry(index, PassSize(index, 4));
+  }
+};
 
-// Look-up table for trigonometric data.
 template<typename T, size_t num_passes>
 class LutPhasor {
  public:
@@ -101,24 +328,13 @@ class LutPhasor {
   ~LutPhasor() { }
   
   void Init() {
-    Math<T> math;
-  
-    for (size_t pass = 3; pass < num_passes; ++pass) {
-      size_t pass_size = 1L << (pass - 1);
-      T* pass_ptr = &trig_lut_[(1L << (pass - 1)) - 4];
-      T increment = math.pi() / (pass_size << 1);
-      T phase = 0.0;
-      for (size_t i = 0; i < pass_size; ++i) {
-        pass_ptr[i] = math.cos(phase);
-        phase += increment;
-      }
-    }
+    Lut::Init();
   }
   
   inline void Start(size_t pass) {
     size_t pass_size = 1 << (pass - 1);
-    cos_ptr_ = &trig_lut_[pass_size - 4 + 1];
-    sin_ptr_ = &trig_lut_[pass_size + pass_size - 4 - 1];
+    cos_ptr_ = &Lut::values[pass_size - 4 + 1];
+    sin_ptr_ = &Lut::values[pass_size + pass_size - 4 - 1];
   }
   
   inline void Rotate() {
@@ -130,9 +346,13 @@ class LutPhasor {
   inline T sin() const { return *sin_ptr_; }
   
  private:
-  T trig_lut_[(1 << (num_passes - 1)) - 4];
-  T* cos_ptr_;
-  T* sin_ptr_;
+  enum {
+    lut_size = (1 << (num_passes - 1)) - 4
+  };
+  typedef ConstantTable<T, TrigLutGenerator<T>, lut_size> Lut;
+  
+  const T* cos_ptr_;
+  const T* sin_ptr_;
   
   DISALLOW_COPY_AND_ASSIGN(LutPhasor);
 };
@@ -151,7 +371,16 @@ struct LutPhasor<T, 3> {
 };
 
 
-// Another way of generating roots of unity.
+// Another way of generating roots of unity. For each pass, from 3,
+// cos(pi / 2^pass) and sin(pi / 2^pass).
+template<typename T>
+struct SinCosLutGenerator {
+  static SHY_FFT_CONSTEXPR T Entry(size_t index) {
+    return Math<T>::twiddle(TableMath::sin(TableMath::pi() * (
+        (index & 1 ? 0.0 : 0.5) + 1.0 / (8 << (index >> 1)))));
+  }
+};
+
 template<typename T, size_t num_passes>
 class RotationPhasor {
  public:
@@ -159,19 +388,13 @@ class RotationPhasor {
   ~RotationPhasor() { }
   
   void Init() {
-    Math<T> math;
-    for (size_t pass = 3; pass < num_passes; ++pass) {
-      size_t index = (pass - 3) << 1;
-      T angle = math.pi() / (1 << pass);
-      sin_cos_lut_[index] = math.cos(angle);
-      sin_cos_lut_[index + 1] = math.sin(angle);
-    }
+    Lut::Init();
   }
   
   inline void Start(size_t pass) {
     size_t index = (pass - 3) << 1;
-    cos_ = real_ = sin_cos_lut_[index];
-    sin_ = imag_ = sin_cos_lut_[index + 1];
+    cos_ = real_ = Lut::values[index];
+    sin_ = imag_ = Lut::values[index + 1];
   }
   
   inline void Rotate() {
@@ -184,7 +407,8 @@ class RotationPhasor {
   inline T sin() const { return sin_; }
   
  private:
-  T sin_cos_lut_[(num_passes - 3) << 1];
+  typedef ConstantTable<T, SinCosLutGenerator<T>, (num_passes - 3) << 1> Lut;
+  
   T cos_;
   T sin_;
   T real_;
@@ -226,11 +450,11 @@ struct DirectTransform {
     
     // First and second pass.
     d = output;
+    size_t r = 0;
     for (size_t i = 0; i < size; i += 4) {
       const T* s = input;
-      size_t r0 = num_passes <= 8
-          ? bit_rev[i >> 2]
-          : ((bit_rev[i & 0xff] << 8) | bit_rev[i >> 8]) >> (16 - num_passes);
+      size_t r0 = num_passes <= 8 ? bit_rev[i >> 2] : r;
+      r = BitReversedIncrement(r, size >> 3);
       size_t r1 = r0 + 2 * (size >> 2);
       size_t r2 = r0 + 1 * (size >> 2);
       size_t r3 = r0 + 3 * (size >> 2);
@@ -325,10 +549,9 @@ struct DirectTransform {
     size_t rt_size = 1 << rt_num_passes;
     // First and second pass.
     d = output;
+    size_t r0 = 0;
     for (size_t i = 0; i < rt_size; i += 4) {
       const T* s = input;
-      size_t r0 = \
-          ((bit_rev[i & 0xff] << 8) | bit_rev[i >> 8]) >> (16 - rt_num_passes);
       size_t r1 = r0 + 2 * (rt_size >> 2);
       size_t r2 = r0 + 1 * (rt_size >> 2);
       size_t r3 = r0 + 3 * (rt_size >> 2);
@@ -340,6 +563,7 @@ struct DirectTransform {
       d[0] = a + b;
       d[2] = a - b;
       d += 4;
+      r0 = BitReversedIncrement(r0, rt_size >> 3);
     }
     
     // Third pass.
@@ -525,10 +749,10 @@ struct InverseTransform {
     // First and second pass.
     s = input;
     d = output;
+    size_t r = 0;
     for (size_t i = 0; i < size; i += 4) {
-      size_t r0 = num_passes <= 8
-          ? bit_rev[i >> 2]
-          : ((bit_rev[i & 0xff] << 8) | bit_rev[i >> 8]) >> (16 - num_passes);
+      size_t r0 = num_passes <= 8 ? bit_rev[i >> 2] : r;
+      r = BitReversedIncrement(r, size >> 3);
       size_t r1 = r0 + 2 * (size >> 2);
       size_t r2 = r0 + 1 * (size >> 2);
       size_t r3 = r0 + 3 * (size >> 2);
@@ -626,9 +850,8 @@ struct InverseTransform {
     // First and second pass.
     s = input;
     d = output;
+    size_t r0 = 0;
     for (size_t i = 0; i < rt_size; i += 4) {
-      size_t r0 = \
-            ((bit_rev[i & 0xff] << 8) | bit_rev[i >> 8]) >> (16 - rt_num_passes);
       size_t r1 = r0 + 2 * (rt_size >> 2);
       size_t r2 = r0 + 1 * (rt_size >> 2);
       size_t r3 = r0 + 3 * (rt_size >> 2);
@@ -643,6 +866,7 @@ struct InverseTransform {
       d[r2] = b_2 + b_3;
       d[r3] = b_2 - b_3;
       s += 4;
+      r0 = BitReversedIncrement(r0, rt_size >> 3);
     }
   }
 };
@@ -676,6 +900,346 @@ struct InverseTransform<T, 2, Phasor> {
 };
 
 
+// Block floating point. Returns the shift to apply to a block of fixed point
+// samples so that they fit in [-2^(fractional_bits - 2), 2^(fractional_bits -
+// 2)) (negative if the block can be amplified). None of the stages of the
+// transforms below amplifies its input by more than 4, so they cannot
+// overflow.
+template<typename T>
+inline int32_t BlockExponent(const T* x, size_t size) {
+  uint32_t m = 0;
+  for (size_t i = 0; i < size; ++i) {
+    int32_t v = x[i];
+    m |= static_cast<uint32_t>(v ^ (v >> 31));
+  }
+  if (!m) {
+    return 0;
+  }
+  int32_t bits = 0;
+  while (m) {
+    m >>= 1;
+    ++bits;
+  }
+  return bits - (Math<T>::fractional_bits - 2);
+}
+
+// Scales samples by 2^-shift, with rounding, as they are read. Rounding can
+// bring the largest positive samples up to 2^(fractional_bits - 2), so the
+// result is saturated to keep the 4-term sums of the transforms in range.
+template<typename T>
+class BlockScaler {
+ private:
+  typedef typename Math<T>::Product P;
+  
+ public:
+  BlockScaler(int32_t shift) {
+    gain_ = shift < 0 ? P(1) << -shift : 1;
+    right_ = shift > 0 ? shift : 0;
+    round_ = shift > 0 ? P(1) << (shift - 1) : 0;
+  }
+  
+  inline int32_t operator()(T x) const {
+    const P max = (P(1) << (Math<T>::fractional_bits - 2)) - 1;
+    P y = (P(x) * gain_ + round_) >> right_;
+    return static_cast<int32_t>(y > max ? max : y);
+  }
+  
+ private:
+  P gain_;
+  int32_t right_;
+  P round_;
+};
+
+// Fixed point direct transform, with the same structure as DirectTransform.
+// Returns the exponent of the output block.
+template<typename T, size_t num_passes, typename Phasor>
+struct FixedPointDirectTransform {
+ private:
+  enum {
+    size = 1 << num_passes,
+    q = Math<T>::fractional_bits
+  };
+  typedef typename Math<T>::Product P;
+  
+  static inline int32_t Round(P x) {
+    return static_cast<int32_t>((x + (P(1) << (q - 1))) >> q);
+  }
+  
+ public:
+  int32_t operator()(
+      T* input,
+      T* output,
+      const uint8_t* bit_rev,
+      Phasor* phasor) {
+    T* s;
+    T* d;
+    Math<T> math;
+    const P sqrt_2_div_2 = math.sqrt_2_div_2();
+    
+    // First and second pass.
+    int32_t shift = BlockExponent(input, size);
+    int32_t exponent = shift;
+    d = output;
+    {
+      BlockScaler<T> scale(shift);
+      size_t r = 0;
+      for (size_t i = 0; i < size; i += 4) {
+        const T* s = input;
+        size_t r0 = num_passes <= 8 ? bit_rev[i >> 2] : r;
+        r = BitReversedIncrement(r, size >> 3);
+        size_t r1 = r0 + 2 * (size >> 2);
+        size_t r2 = r0 + 1 * (size >> 2);
+        size_t r3 = r0 + 3 * (size >> 2);
+        
+        int32_t x0 = scale(s[r0]);
+        int32_t x1 = scale(s[r1]);
+        int32_t x2 = scale(s[r2]);
+        int32_t x3 = scale(s[r3]);
+        
+        d[1] = x0 - x1;
+        d[3] = x2 - x3;
+        int32_t a = x0 + x1;
+        int32_t b = x2 + x3;
+        d[0] = a + b;
+        d[2] = a - b;
+        d += 4;
+      }
+    }
+    
+    // Third pass.
+    s = output;
+    d = input;
+    shift = BlockExponent(s, size);
+    exponent += shift;
+    {
+      BlockScaler<T> scale(shift);
+      for (size_t i = 0; i < size; i += 8) {
+        int32_t x0 = scale(s[i]);
+        int32_t x1 = scale(s[i + 1]);
+        int32_t x3 = scale(s[i + 3]);
+        int32_t x4 = scale(s[i + 4]);
+        int32_t x5 = scale(s[i + 5]);
+        int32_t x7 = scale(s[i + 7]);
+        int32_t v;
+        
+        d[i] = x0 + x4;
+        d[i + 4] = x0 - x4;
+        d[i + 2] = scale(s[i + 2]);
+        d[i + 6] = scale(s[i + 6]);
+        
+        v = Round((x5 - x7) * sqrt_2_div_2);
+        d[i + 1] = x1 + v;
+        d[i + 3] = x1 - v;
+        
+        v = Round((x5 + x7) * sqrt_2_div_2);
+        d[i + 5] = v + x3;
+        d[i + 7] = v - x3;
+      }
+    }
+    
+    // Remaining passes.
+    for (size_t pass = 3; pass < num_passes; ++pass) {
+      // Flip source and destination pointers
+      {
+        T* tmp = s;
+        s = d;
+        d = tmp;
+      }
+      
+      shift = BlockExponent(s, size);
+      exponent += shift;
+      BlockScaler<T> scale(shift);
+      
+      size_t n = 1 << pass;
+      size_t n_2 = n >> 1;
+      
+      for (size_t i = 0; i < size; i += (n << 1)) {
+        T* s1r = s + i;
+        T* s2r = s1r + n;
+        T* dr = d + i;
+        T* di = dr + n;
+        
+        int32_t a = scale(s1r[0]);
+        int32_t b = scale(s2r[0]);
+        dr[0] = a + b;
+        di[0] = a - b;
+        dr[n_2] = scale(s1r[n_2]);
+        di[n_2] = scale(s2r[n_2]);
+        T* s1i = s1r + n_2;
+        T* s2i = s1i + n;
+        phasor->Start(pass);
+        for (size_t j = 1; j < n_2; ++j) {
+          P c = phasor->cos();
+          P s = phasor->sin();
+          int32_t x1r = scale(s1r[j]);
+          int32_t x1i = scale(s1i[j]);
+          int32_t x2r = scale(s2r[j]);
+          int32_t x2i = scale(s2i[j]);
+          int32_t v;
+          
+          v = Round(x2r * c - x2i * s);
+          dr[j] = x1r + v;
+          di[-j] = x1r - v;
+          
+          v = Round(x2r * s + x2i * c);
+          di[j] = v + x1i;
+          di[n - j] = v - x1i;
+          phasor->Rotate();
+        }
+      }
+    }
+    
+    if (d != output) {
+      std::copy(&d[0], &d[size], &output[0]);
+    }
+    return exponent;
+  }
+};
+
+// Fixed point inverse transform, with the same structure as
+// InverseTransform. Returns the exponent of the output block.
+template<typename T, size_t num_passes, typename Phasor>
+struct FixedPointInverseTransform {
+ private:
+  enum {
+    size = 1 << num_passes,
+    q = Math<T>::fractional_bits
+  };
+  typedef typename Math<T>::Product P;
+  
+  static inline int32_t Round(P x) {
+    return static_cast<int32_t>((x + (P(1) << (q - 1))) >> q);
+  }
+  
+ public:
+  int32_t operator()(
+      T* input,
+      T* output,
+      const uint8_t* bit_rev,
+      Phasor* phasor) {
+    T* s = input;
+    T* d = output;
+    Math<T> math;
+    const P sqrt_2_div_2 = math.sqrt_2_div_2();
+    int32_t exponent = 0;
+    int32_t shift;
+    
+    // Remaining passes.
+    for (size_t pass = num_passes - 1; pass >= 3; --pass) {
+      shift = BlockExponent(s, size);
+      exponent += shift;
+      BlockScaler<T> scale(shift);
+      
+      size_t n = 1 << pass;
+      size_t n_2 = n >> 1;
+      
+      for (size_t i = 0; i < size; i += (n << 1)) {
+        T* sr = s + i;
+        T* si = sr + n;
+        T* d1r = d + i;
+        T* d2r = d1r + n;
+        
+        int32_t a = scale(sr[0]);
+        int32_t b = scale(si[0]);
+        d1r[0] = a + b;
+        d2r[0] = a - b;
+        d1r[n_2] = scale(sr[n_2]) * 2;
+        d2r[n_2] = scale(si[n_2]) * 2;
+        
+        T* d1i = d1r + n_2;
+        T* d2i = d1i + n;
+        phasor->Start(pass);
+        for (size_t j = 1; j < n_2; ++j) {
+          int32_t xr = scale(sr[j]);
+          int32_t xi = scale(si[j]);
+          int32_t yr = scale(si[-j]);
+          int32_t yi = scale(si[n - j]);
+          d1r[j] = xr + yr;
+          d1i[j] = xi - yi;
+          
+          P c = phasor->cos();
+          P s = phasor->sin();
+          int32_t vr = xr - yr;
+          int32_t vi = xi + yi;
+          
+          d2r[j] = Round(vr * c + vi * s);
+          d2i[j] = Round(vi * c - vr * s);
+          phasor->Rotate();
+        }
+      }
+      
+      // Flip source and destination pointers for the next pass.
+      if (d == output) {
+        s = output;
+        d = input;
+      } else {
+        s = input;
+        d = output;
+      }
+    }
+    
+    // Copy data if necessary.
+    if (d == output) {
+      std::copy(&s[0], &s[size], &output[0]);
+    }
+    
+    s = output;
+    d = input;
+    shift = BlockExponent(s, size);
+    exponent += shift;
+    {
+      BlockScaler<T> scale(shift);
+      for (size_t i = 0; i < size; i += 8) {
+        int32_t x1 = scale(s[i + 1]);
+        int32_t x3 = scale(s[i + 3]);
+        int32_t x5 = scale(s[i + 5]);
+        int32_t x7 = scale(s[i + 7]);
+        int32_t vr, vi;
+        d[i] = scale(s[i]) + scale(s[i + 4]);
+        d[i + 4] = scale(s[i]) - scale(s[i + 4]);
+        d[i + 2] = scale(s[i + 2]) * 2;
+        d[i + 6] = scale(s[i + 6]) * 2;
+        d[i + 1] = x1 + x3;
+        d[i + 3] = x5 - x7;
+        vr = x1 - x3;
+        vi = x5 + x7;
+        d[i + 5] = Round((vr + vi) * sqrt_2_div_2);
+        d[i + 7] = Round((vi - vr) * sqrt_2_div_2);
+      }
+    }
+    
+    // First and second pass.
+    s = input;
+    d = output;
+    shift = BlockExponent(s, size);
+    exponent += shift;
+    {
+      BlockScaler<T> scale(shift);
+      size_t r = 0;
+      for (size_t i = 0; i < size; i += 4) {
+        size_t r0 = num_passes <= 8 ? bit_rev[i >> 2] : r;
+        r = BitReversedIncrement(r, size >> 3);
+        size_t r1 = r0 + 2 * (size >> 2);
+        size_t r2 = r0 + 1 * (size >> 2);
+        size_t r3 = r0 + 3 * (size >> 2);
+        
+        int32_t b_0 = scale(s[0]) + scale(s[2]);
+        int32_t b_2 = scale(s[0]) - scale(s[2]);
+        int32_t b_1 = scale(s[1]) * 2;
+        int32_t b_3 = scale(s[3]) * 2;
+        
+        d[r0] = b_0 + b_1;
+        d[r1] = b_0 - b_1;
+        d[r2] = b_2 + b_3;
+        d[r3] = b_2 - b_3;
+        s += 4;
+      }
+    }
+    return exponent;
+  }
+};
+
+
 template<
     typename T=float,
     size_t size=16,
@@ -695,20 +1259,7 @@ class ShyFFT {
   ~ShyFFT() { }
   
   void Init() {
-    bit_rev_[0] = 0;
-    for (size_t i = 1; i < sizeof(bit_rev_); ++i) {
-      uint8_t byte = 0;
-      uint8_t source = i << 2;
-      uint8_t destination = static_cast<uint8_t>(size >> 1);
-      while (source) {
-        if (source & 1) {
-          byte |= destination;
-        }
-        destination >>= 1;
-        source >>= 1;
-      }
-      bit_rev_[i] = byte;
-    }
+    BitReversal::Init();
     phasor_.Init();
   }
   
@@ -717,7 +1268,7 @@ class ShyFFT {
     d(
         input,
         output,
-        num_passes <= 8 ? &bit_rev_[0] : bit_rev_256_lut_,
+        BitReversal::values,
         &phasor_);
   }
   
@@ -726,7 +1277,33 @@ class ShyFFT {
     i(
         input,
         output,
-        num_passes <= 8 ? &bit_rev_[0] : bit_rev_256_lut_,
+        BitReversal::values,
+        &phasor_);
+  }
+  
+  // Runs num_transforms transforms of the same size in one pass, sharing the
+  // walk through the bit-reversal and twiddle tables. The buffers are
+  // interleaved: sample i of transform k is at input[i * num_transforms + k].
+  // The output has the same layout.
+  template<size_t num_transforms>
+  void DirectBatch(T* input, T* output) {
+    typedef Lanes<T, num_transforms> L;
+    DirectTransform<L, num_passes, Phasor<T, num_passes> > d;
+    d(
+        reinterpret_cast<L*>(input),
+        reinterpret_cast<L*>(output),
+        BitReversal::values,
+        &phasor_);
+  }
+  
+  template<size_t num_transforms>
+  void InverseBatch(T* input, T* output) {
+    typedef Lanes<T, num_transforms> L;
+    InverseTransform<L, num_passes, Phasor<T, num_passes> > i;
+    i(
+        reinterpret_cast<L*>(input),
+        reinterpret_cast<L*>(output),
+        BitReversal::values,
         &phasor_);
   }
   
@@ -735,7 +1312,7 @@ class ShyFFT {
     d(
         input,
         output,
-        bit_rev_256_lut_,
+        BitReversal::values,
         &phasor_,
         n);
   }
@@ -745,7 +1322,7 @@ class ShyFFT {
     i(
         input,
         output,
-        bit_rev_256_lut_,
+        BitReversal::values,
         &phasor_,
         n);
   }
@@ -753,18 +1330,62 @@ class ShyFFT {
 
  private:
   PhasorType phasor_;
-  uint8_t bit_rev_[BitReversalLut<num_passes>::size];
-  static const uint8_t bit_rev_256_lut_[256];
+  typedef ConstantTable<
+      uint8_t,
+      BitReversalGenerator<num_passes>,
+      BitReversalLut<num_passes>::size> BitReversal;
 
   DISALLOW_COPY_AND_ASSIGN(ShyFFT);
 };
 
-template<typename T, size_t size, template <typename, size_t> class Phasor>
-const uint8_t ShyFFT<T, size, Phasor>::bit_rev_256_lut_[256] = {
-#define R2(n) n, n + 2*64, n + 1*64, n + 3*64
-#define R4(n) R2(n), R2(n + 2*16), R2(n + 1*16), R2(n + 3*16)
-#define R6(n) R4(n), R4(n + 2*4 ), R4(n + 1*4 ), R4(n + 3*4 )
-R6(0), R6(2), R6(1), R6(3)
+// Fixed point transforms for targets without FPU, with int16_t (Q15) or
+// int32_t (Q31) samples. The block is rescaled before each pass (block
+// floating point) and Direct / Inverse return the exponent of the output:
+// output * 2^exponent is the transform of the input, with the same (lack of)
+// normalization as the floating point version. Sizes of at least 8 points
+// only, with LutPhasor.
+template<typename T, size_t size>
+class FixedPointShyFFT {
+ public:
+  enum {
+    num_passes = Log2<size>::value,
+    max_size = size
+  };
+  
+  FixedPointShyFFT() { }
+  ~FixedPointShyFFT() { }
+  
+  void Init() {
+    BitReversal::Init();
+    phasor_.Init();
+  }
+  
+  int32_t Direct(T* input, T* output) {
+    FixedPointDirectTransform<T, num_passes, LutPhasor<T, num_passes> > d;
+    return d(input, output, BitReversal::values, &phasor_);
+  }
+  
+  int32_t Inverse(T* input, T* output) {
+    FixedPointInverseTransform<T, num_passes, LutPhasor<T, num_passes> > i;
+    return i(input, output, BitReversal::values, &phasor_);
+  }
+  
+ private:
+  LutPhasor<T, num_passes> phasor_;
+  typedef ConstantTable<
+      uint8_t,
+      BitReversalGenerator<num_passes>,
+      BitReversalLut<num_passes>::size> BitReversal;
+  
+  DISALLOW_COPY_AND_ASSIGN(FixedPointShyFFT);
+};
+
+template<size_t size, template <typename, size_t> class Phasor>
+class ShyFFT<int16_t, size, Phasor> : public FixedPointShyFFT<int16_t, size> {
+};
+
+template<size_t size, template <typename, size_t> class Phasor>
+class ShyFFT<int32_t, size, Phasor> : public FixedPointShyFFT<int32_t, size> {
 };
 
 }  // namespace stmlib
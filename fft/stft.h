@@ -0,0 +1,215 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Short time Fourier transform: framing, windowing, overlap-add and
+// scheduling around ShyFFT, for spectral effects.
+//
+// Input blocks can have any size. Each frame goes through 5 steps (analysis
+// window, direct FFT, spectral processing, inverse FFT, synthesis window and
+// overlap-add), which are run as the next hop of input is received - so with
+// audio blocks smaller than the hop, the cost of a frame is spread over
+// several calls instead of being spent at once. The latency is
+// fft_size + hop samples.
+
+#ifndef STMLIB_FFT_STFT_H_
+#define STMLIB_FFT_STFT_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "stmlib/fft/shy_fft.h"
+#include "stmlib/utils/buffer_allocator.h"
+
+namespace stmlib {
+
+template<size_t fft_size, size_t hop>
+class Stft {
+ public:
+  typedef ShyFFT<float, fft_size> FFT;
+  
+  enum {
+    // Input history and overlap-add accumulator (each fft_size + hop),
+    // frame, spectrum and window (each fft_size).
+    buffer_size = 5 * fft_size + 2 * hop,
+    latency = fft_size + hop
+  };
+  
+  Stft() { }
+  ~Stft() { }
+  
+  // The FFT is initialized by the caller, and can be shared by several
+  // instances (for example one per channel).
+  bool Init(FFT* fft, BufferAllocator* allocator) {
+    return Init(fft, allocator->Allocate<float>(buffer_size));
+  }
+  
+  bool Init(FFT* fft, float* buffer) {
+    STATIC_ASSERT(fft_size % hop == 0 && fft_size >= 2 * hop, invalid_hop);
+    if (!buffer) {
+      return false;
+    }
+    fft_ = fft;
+    history_ = buffer;
+    accumulator_ = history_ + RING_SIZE;
+    frame_ = accumulator_ + RING_SIZE;
+    spectrum_ = frame_ + fft_size;
+    window_ = spectrum_ + fft_size;
+    
+    // Square root of a periodic Hann window, applied before and after
+    // processing. The normalization of the overlap-add and of the inverse
+    // FFT is done with the synthesis window.
+    for (size_t i = 0; i < fft_size; ++i) {
+      window_[i] = sinf(3.141592653589793f * i / fft_size);
+    }
+    synthesis_gain_ = 2.0f * hop / (float(fft_size) * float(fft_size));
+    
+    std::fill(&history_[0], &history_[RING_SIZE], 0.0f);
+    std::fill(&accumulator_[0], &accumulator_[RING_SIZE], 0.0f);
+    ptr_ = 0;
+    phase_ = 0;
+    frame_ptr_ = 0;
+    step_ = NUM_STEPS;
+    return true;
+  }
+  
+  // processor is called once per frame as (*processor)(spectrum), with the
+  // spectrum in the ShyFFT layout (real parts of bins 0 to fft_size / 2,
+  // followed by the imaginary parts of bins 1 to fft_size / 2 - 1). It can
+  // be called during a later Process() than the one which completed the
+  // frame.
+  template<typename Processor>
+  void Process(
+      Processor* processor,
+      const float* in,
+      float* out,
+      size_t size) {
+    while (size) {
+      size_t n = std::min(size, hop - phase_);
+      size -= n;
+      phase_ += n;
+      while (n--) {
+        history_[ptr_] = *in++;
+        *out++ = accumulator_[ptr_];
+        accumulator_[ptr_] = 0.0f;
+        ptr_ = ptr_ == RING_SIZE - 1 ? 0 : ptr_ + 1;
+      }
+      
+      // Run the steps of the current frame due at this point of the hop.
+      size_t due = (phase_ * NUM_STEPS + hop - 1) / hop;
+      while (step_ < due) {
+        RunStep(processor);
+      }
+      
+      if (phase_ == hop) {
+        // A new frame made of the last fft_size samples is ready.
+        phase_ = 0;
+        frame_ptr_ = ptr_ + hop;
+        if (frame_ptr_ >= RING_SIZE) {
+          frame_ptr_ -= RING_SIZE;
+        }
+        step_ = 0;
+      }
+    }
+  }
+  
+ private:
+  enum Step {
+    STEP_ANALYSIS,
+    STEP_DIRECT,
+    STEP_PROCESS,
+    STEP_INVERSE,
+    STEP_SYNTHESIS,
+    NUM_STEPS
+  };
+  
+  enum {
+    RING_SIZE = fft_size + hop
+  };
+  
+  template<typename Processor>
+  void RunStep(Processor* processor) {
+    // The frame covers fft_size samples of the ring, starting at frame_ptr_.
+    size_t first = std::min(
+        static_cast<size_t>(fft_size), RING_SIZE - frame_ptr_);
+    switch (step_) {
+      case STEP_ANALYSIS:
+        for (size_t i = 0; i < first; ++i) {
+          frame_[i] = history_[frame_ptr_ + i] * window_[i];
+        }
+        for (size_t i = first; i < fft_size; ++i) {
+          frame_[i] = history_[i - first] * window_[i];
+        }
+        break;
+        
+      case STEP_DIRECT:
+        fft_->Direct(frame_, spectrum_);
+        break;
+        
+      case STEP_PROCESS:
+        (*processor)(spectrum_);
+        break;
+        
+      case STEP_INVERSE:
+        fft_->Inverse(spectrum_, frame_);
+        break;
+        
+      case STEP_SYNTHESIS:
+        {
+          const float gain = synthesis_gain_;
+          for (size_t i = 0; i < first; ++i) {
+            accumulator_[frame_ptr_ + i] += frame_[i] * window_[i] * gain;
+          }
+          for (size_t i = first; i < fft_size; ++i) {
+            accumulator_[i - first] += frame_[i] * window_[i] * gain;
+          }
+        }
+        break;
+    }
+    ++step_;
+  }
+  
+  FFT* fft_;
+  
+  float* history_;
+  float* accumulator_;
+  float* frame_;
+  float* spectrum_;
+  float* window_;
+  float synthesis_gain_;
+  
+  size_t ptr_;
+  size_t phase_;
+  size_t frame_ptr_;
+  size_t step_;
+  
+  DISALLOW_COPY_AND_ASSIGN(Stft);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_FFT_STFT_H_
@@ -0,0 +1,227 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Biquad cascade: each shape matches a direct form I section designed in
+// double precision from the cookbook formulas, and the block and per-sample
+// versions of Process agree.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "stmlib/dsp/biquad.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+float Random() {
+  return static_cast<float>(rand()) / RAND_MAX - 0.5f;
+}
+
+enum Shape {
+  SHAPE_LOW_PASS,
+  SHAPE_HIGH_PASS,
+  SHAPE_BAND_PASS,
+  SHAPE_NOTCH,
+  SHAPE_ALL_PASS,
+  SHAPE_PEAKING,
+  SHAPE_LOW_SHELF,
+  SHAPE_HIGH_SHELF,
+  SHAPE_LAST
+};
+
+const char* shape_names[] = {
+  "low pass", "high pass", "band pass", "notch", "all pass", "peaking",
+  "low shelf", "high shelf"
+};
+
+const size_t kNumSections = 3;
+const size_t kSize = 4096;
+
+// Direct form I second order section.
+struct ReferenceBiquad {
+  void Init(Shape shape, double f, double q, double gain_db) {
+    double omega = 2.0 * M_PI * f;
+    double cs = cos(omega);
+    double alpha = sin(omega) / (2.0 * q);
+    double a = pow(10.0, gain_db / 40.0);
+    double k = 2.0 * sqrt(a) * alpha;
+    double b[3];
+    double a0;
+    a1 = -2.0 * cs;
+    a2 = 1.0 - alpha;
+    a0 = 1.0 + alpha;
+    switch (shape) {
+      case SHAPE_LOW_PASS:
+        b[0] = b[2] = (1.0 - cs) / 2.0; b[1] = 1.0 - cs;
+        break;
+      case SHAPE_HIGH_PASS:
+        b[0] = b[2] = (1.0 + cs) / 2.0; b[1] = -(1.0 + cs);
+        break;
+      case SHAPE_BAND_PASS:
+        b[0] = alpha; b[1] = 0.0; b[2] = -alpha;
+        break;
+      case SHAPE_NOTCH:
+        b[0] = b[2] = 1.0; b[1] = -2.0 * cs;
+        break;
+      case SHAPE_ALL_PASS:
+        b[0] = 1.0 - alpha; b[1] = -2.0 * cs; b[2] = 1.0 + alpha;
+        break;
+      case SHAPE_PEAKING:
+        b[0] = 1.0 + alpha * a; b[1] = -2.0 * cs; b[2] = 1.0 - alpha * a;
+        a0 = 1.0 + alpha / a; a2 = 1.0 - alpha / a;
+        break;
+      case SHAPE_LOW_SHELF:
+        b[0] = a * ((a + 1.0) - (a - 1.0) * cs + k);
+        b[1] = 2.0 * a * ((a - 1.0) - (a + 1.0) * cs);
+        b[2] = a * ((a + 1.0) - (a - 1.0) * cs - k);
+        a0 = (a + 1.0) + (a - 1.0) * cs + k;
+        a1 = -2.0 * ((a - 1.0) + (a + 1.0) * cs);
+        a2 = (a + 1.0) + (a - 1.0) * cs - k;
+        break;
+      default:
+        b[0] = a * ((a + 1.0) + (a - 1.0) * cs + k);
+        b[1] = -2.0 * a * ((a - 1.0) + (a + 1.0) * cs);
+        b[2] = a * ((a + 1.0) + (a - 1.0) * cs - k);
+        a0 = (a + 1.0) - (a - 1.0) * cs + k;
+        a1 = 2.0 * ((a - 1.0) - (a + 1.0) * cs);
+        a2 = (a + 1.0) - (a - 1.0) * cs - k;
+        break;
+    }
+    b0 = b[0] / a0;
+    b1 = b[1] / a0;
+    b2 = b[2] / a0;
+    a1 /= a0;
+    a2 /= a0;
+    x1 = x2 = y1 = y2 = 0.0;
+  }
+
+  double Process(double x) {
+    double y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+    x2 = x1;
+    x1 = x;
+    y2 = y1;
+    y1 = y;
+    return y;
+  }
+
+  double b0, b1, b2, a1, a2;
+  double x1, x2, y1, y2;
+};
+
+void Design(
+    BiquadCascade<kNumSections>* cascade,
+    size_t section,
+    Shape shape,
+    float f,
+    float q,
+    float gain_db) {
+  switch (shape) {
+    case SHAPE_LOW_PASS: cascade->set_low_pass(section, f, q); break;
+    case SHAPE_HIGH_PASS: cascade->set_high_pass(section, f, q); break;
+    case SHAPE_BAND_PASS: cascade->set_band_pass(section, f, q); break;
+    case SHAPE_NOTCH: cascade->set_notch(section, f, q); break;
+    case SHAPE_ALL_PASS: cascade->set_all_pass(section, f, q); break;
+    case SHAPE_PEAKING:
+      cascade->set_peaking(section, f, q, gain_db);
+      break;
+    case SHAPE_LOW_SHELF:
+      cascade->set_low_shelf(section, f, q, gain_db);
+      break;
+    default:
+      cascade->set_high_shelf(section, f, q, gain_db);
+      break;
+  }
+}
+
+// All the sections of the cascade have the same shape, with different
+// frequencies, resonances and gains.
+void TestShape(CheckList* check, Shape shape) {
+  static const float f[kNumSections] = { 0.004f, 0.05f, 0.3f };
+  static const float q[kNumSections] = { 0.707f, 2.0f, 5.0f };
+  static const float gain_db[kNumSections] = { 6.0f, -12.0f, 3.0f };
+
+  BiquadCascade<kNumSections> cascade;
+  BiquadCascade<kNumSections> block_cascade;
+  ReferenceBiquad reference[kNumSections];
+  cascade.Init();
+  block_cascade.Init();
+  for (size_t i = 0; i < kNumSections; ++i) {
+    Design(&cascade, i, shape, f[i], q[i], gain_db[i]);
+    Design(&block_cascade, i, shape, f[i], q[i], gain_db[i]);
+    reference[i].Init(shape, f[i], q[i], gain_db[i]);
+  }
+
+  static float in[kSize];
+  static float out[kSize];
+  for (size_t i = 0; i < kSize; ++i) {
+    in[i] = Random();
+  }
+
+  // Uneven blocks, the last one in place.
+  size_t done = 0;
+  size_t block_size = 1;
+  while (done < kSize) {
+    size_t size = std::min(block_size, kSize - done);
+    if (done + size == kSize) {
+      std::copy(&in[done], &in[kSize], &out[done]);
+      block_cascade.Process(&out[done], &out[done], size);
+    } else {
+      block_cascade.Process(&in[done], &out[done], size);
+    }
+    done += size;
+    block_size = block_size * 3 + 1;
+  }
+
+  float error = 0.0f;
+  float block_error = 0.0f;
+  for (size_t n = 0; n < kSize; ++n) {
+    double expected = in[n];
+    for (size_t i = 0; i < kNumSections; ++i) {
+      expected = reference[i].Process(expected);
+    }
+    float y = cascade.Process(in[n]);
+    error = std::max(error, static_cast<float>(fabs(y - expected)));
+    block_error = std::max(block_error, fabsf(out[n] - y));
+  }
+  (*check)(
+      error < 1e-4f,
+      "%s: matches direct form I (error %g)",
+      shape_names[shape], error);
+  (*check)(
+      block_error == 0.0f,
+      "%s: block and per-sample Process agree (error %g)",
+      shape_names[shape], block_error);
+}
+
+int main(void) {
+  CheckList check;
+  srand(42);
+  for (int32_t shape = 0; shape < SHAPE_LAST; ++shape) {
+    TestShape(&check, static_cast<Shape>(shape));
+  }
+  return check.exit_code();
+}
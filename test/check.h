@@ -0,0 +1,68 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Minimal checks for the host tests (see test/makefile). Each check prints
+// its result; a test exits with a non-zero code if any check failed.
+
+#ifndef STMLIB_TEST_CHECK_H_
+#define STMLIB_TEST_CHECK_H_
+
+#include <cstdarg>
+#include <cstdio>
+
+namespace stmlib {
+
+class CheckList {
+ public:
+  CheckList() : num_checks_(0), num_failures_(0) { }
+  ~CheckList() { }
+
+  void operator()(bool passed, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    printf(passed ? "  ok    " : "  FAIL  ");
+    vprintf(format, args);
+    printf("\n");
+    va_end(args);
+    ++num_checks_;
+    if (!passed) {
+      ++num_failures_;
+    }
+  }
+
+  int exit_code() const {
+    printf("%d/%d checks passed\n", num_checks_ - num_failures_, num_checks_);
+    return num_failures_ ? 1 : 0;
+  }
+
+ private:
+  int num_checks_;
+  int num_failures_;
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_TEST_CHECK_H_
@@ -0,0 +1,101 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// The bands of a MultibandCrossover sum to an allpass: the magnitude response
+// of the sum of the bands must be flat.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "stmlib/dsp/filter.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+const size_t kSize = 8192;
+
+template<size_t num_bands>
+void TestFlatness(CheckList* check, const float* f) {
+  MultibandCrossover<num_bands> crossover;
+  crossover.Init();
+  for (size_t i = 0; i < num_bands - 1; ++i) {
+    crossover.template set_f<FREQUENCY_ACCURATE>(i, f[i]);
+  }
+
+  static float in[kSize];
+  static float bands[num_bands][kSize];
+  float* out[num_bands];
+  for (size_t i = 0; i < num_bands; ++i) {
+    out[i] = bands[i];
+  }
+  std::fill(&in[0], &in[kSize], 0.0f);
+  in[0] = 1.0f;
+
+  // Process in blocks of varying sizes.
+  size_t done = 0;
+  for (size_t block = 1; done < kSize; block = block * 2 + 1) {
+    size_t size = std::min(block, kSize - done);
+    float* o[num_bands];
+    for (size_t i = 0; i < num_bands; ++i) {
+      o[i] = out[i] + done;
+    }
+    crossover.Process(&in[done], o, size);
+    done += size;
+  }
+
+  double max_error = 0.0;
+  for (size_t k = 1; k < kSize / 2; k += 7) {
+    double re = 0.0;
+    double im = 0.0;
+    for (size_t n = 0; n < kSize; ++n) {
+      double sum = 0.0;
+      for (size_t i = 0; i < num_bands; ++i) {
+        sum += bands[i][n];
+      }
+      double phase = 2.0 * M_PI * static_cast<double>(k * n) / kSize;
+      re += sum * cos(phase);
+      im -= sum * sin(phase);
+    }
+    double error = fabs(sqrt(re * re + im * im) - 1.0);
+    max_error = std::max(max_error, error);
+  }
+  (*check)(
+      max_error < 1e-5,
+      "%d bands: magnitude of the sum within %g of unity",
+      static_cast<int>(num_bands), max_error);
+}
+
+int main(void) {
+  CheckList check;
+  const float f2[] = { 0.02f };
+  const float f3[] = { 0.005f, 0.05f };
+  const float f5[] = { 0.003f, 0.01f, 0.04f, 0.15f };
+  TestFlatness<2>(&check, f2);
+  TestFlatness<3>(&check, f3);
+  TestFlatness<5>(&check, f5);
+  return check.exit_code();
+}
@@ -0,0 +1,340 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Delay lines: multi-tap block reads match per-sample reads, the other
+// accesses to PowerOfTwoDelayLine and DynamicDelayLine match DelayLine, and
+// the storage codecs round to the nearest representable value.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+
+#include "stmlib/dsp/delay_line.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+float Random() {
+  return static_cast<float>(rand()) / RAND_MAX - 0.5f;
+}
+
+const size_t kMaxDelay = 256;
+const size_t kBlockSize = 24;
+const size_t kNumBlocks = 40;
+const size_t kMaxTaps = 9;
+
+// Reference for allpass interpolation, from integer delay reads.
+float ReadAllpass(
+    const PowerOfTwoDelayLine<float, kMaxDelay>& line,
+    float delay,
+    float* state) {
+  int32_t integral = static_cast<int32_t>(delay);
+  float fractional = delay - static_cast<float>(integral);
+  if (fractional < 0.5f) {
+    fractional += 1.0f;
+    --integral;
+  }
+  const float eta = (1.0f - fractional) / (1.0f + fractional);
+  float y = line.Read(static_cast<size_t>(integral + 1)) + eta * (
+      line.Read(static_cast<size_t>(integral)) - *state);
+  *state = y;
+  return y;
+}
+
+template<DelayLineInterpolation interpolation>
+void TestReadTaps(CheckList* check, size_t num_taps, const char* name) {
+  static PowerOfTwoDelayLine<float, kMaxDelay> line;
+  static PowerOfTwoDelayLine<float, kMaxDelay> reference;
+  line.Init();
+  reference.Init();
+
+  float in[kBlockSize];
+  float delays[kBlockSize * kMaxTaps];
+  float out[kBlockSize * kMaxTaps];
+  float state[kMaxTaps];
+  float reference_state[kMaxTaps];
+  std::fill(&state[0], &state[kMaxTaps], 0.0f);
+  std::fill(&reference_state[0], &reference_state[kMaxTaps], 0.0f);
+
+  float error = 0.0f;
+  for (size_t block = 0; block < kNumBlocks; ++block) {
+    for (size_t i = 0; i < kBlockSize; ++i) {
+      in[i] = Random();
+      for (size_t j = 0; j < num_taps; ++j) {
+        // Sweeps the whole range of valid delays.
+        const float range = static_cast<float>(kMaxDelay - kBlockSize - 5);
+        delays[i * num_taps + j] = 2.0f + (Random() + 0.5f) * range;
+      }
+    }
+    line.Write(in, kBlockSize);
+    line.ReadTaps<interpolation>(delays, out, num_taps, kBlockSize, state);
+
+    for (size_t i = 0; i < kBlockSize; ++i) {
+      reference.Write(in[i]);
+      for (size_t j = 0; j < num_taps; ++j) {
+        float delay = delays[i * num_taps + j];
+        float expected;
+        if (interpolation == DELAY_LINE_INTERPOLATION_LINEAR) {
+          expected = reference.Read(delay);
+        } else if (interpolation == DELAY_LINE_INTERPOLATION_HERMITE) {
+          expected = reference.ReadHermite(delay);
+        } else {
+          expected = ReadAllpass(reference, delay, &reference_state[j]);
+        }
+        error = std::max(error, fabsf(out[i * num_taps + j] - expected));
+      }
+    }
+  }
+  (*check)(
+      error < 1e-6f,
+      "%s, %d taps: block read matches per-sample reads (error %g)",
+      name, static_cast<int>(num_taps), error);
+}
+
+// Round trip of a low level sine through a codec. Rounding (instead of
+// truncation) gives an error with no DC component, at most half a step.
+template<typename Codec>
+void TestQ15Codec(CheckList* check, float full_scale, const char* name) {
+  const float step = full_scale / 32768.0f;
+  const size_t size = 48000;
+  double signal = 0.0;
+  double noise = 0.0;
+  double mean_error = 0.0;
+  float max_error = 0.0f;
+  for (size_t i = 0; i < size; ++i) {
+    float x = 0.001f * full_scale * sinf(0.0123f * static_cast<float>(i));
+    float error = Codec::Decompress(Codec::Compress(x)) - x;
+    signal += x * x;
+    noise += error * error;
+    mean_error += error;
+    max_error = std::max(max_error, fabsf(error));
+  }
+  mean_error /= size;
+  // Ideal quantization noise: step^2 / 12.
+  double snr = 10.0 * log10(signal / noise);
+  double ideal_snr = 10.0 * log10(signal / size / (step * step / 12.0));
+  (*check)(
+      max_error <= 0.5f * step * 1.0001f,
+      "%s: error within half a step (%g steps)", name, max_error / step);
+  (*check)(
+      fabs(mean_error) < 0.01 * step,
+      "%s: no DC error (%g steps)", name, mean_error / step);
+  (*check)(
+      snr > ideal_snr - 0.5,
+      "%s: -60 dB sine SNR %.1f dB (ideal %.1f dB)", name, snr, ideal_snr);
+
+  const float large[] = { 1.0e12f, FLT_MAX, HUGE_VALF };
+  bool clipped = true;
+  for (size_t i = 0; i < 3; ++i) {
+    clipped = clipped && Codec::Compress(large[i]) == 32767;
+    clipped = clipped && Codec::Compress(-large[i]) == -32768;
+  }
+  clipped = clipped && Codec::Compress(full_scale) == 32767;
+  clipped = clipped && Codec::Compress(-full_scale) == -32768;
+  (*check)(clipped, "%s: clipped beyond full scale", name);
+}
+
+void TestHalfFloatCodec(CheckList* check) {
+  float max_relative_error = 0.0f;
+  for (float x = 6.2e-5f; x < 65000.0f; x *= 1.0013f) {
+    for (int32_t sign = -1; sign <= 1; sign += 2) {
+      float y = HalfFloatCodec::Decompress(HalfFloatCodec::Compress(x * sign));
+      max_relative_error = std::max(
+          max_relative_error, fabsf(y - x * sign) / x);
+    }
+  }
+  (*check)(
+      max_relative_error <= 1.0f / 2048.0f,
+      "half float: relative error within half a step (%g)",
+      max_relative_error);
+  (*check)(
+      HalfFloatCodec::Decompress(HalfFloatCodec::Compress(1.0e6f)) ==
+          65504.0f &&
+      HalfFloatCodec::Decompress(HalfFloatCodec::Compress(-HUGE_VALF)) ==
+          -65504.0f,
+      "half float: clipped beyond +/-65504");
+}
+
+// Per-sample and block accesses to a PowerOfTwoDelayLine, compared with a
+// DelayLine of the same size written one sample at a time.
+void TestPowerOfTwoDelayLine(CheckList* check) {
+  static PowerOfTwoDelayLine<float, kMaxDelay> line;
+  static DelayLine<float, kMaxDelay> reference;
+  line.Init();
+  reference.Init();
+
+  float max_error[5] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+  size_t num_blocks = 0;
+  for (size_t n = 0; n < 20000; ++n) {
+    if (rand() % 8 == 0) {
+      // Block read then write, compared with Read then Write for each
+      // sample. Requires size <= delay <= max_delay.
+      float in[kMaxDelay];
+      float out[kMaxDelay];
+      size_t delay = 1 + rand() % kMaxDelay;
+      size_t size = 1 + rand() % delay;
+      for (size_t i = 0; i < size; ++i) {
+        in[i] = Random();
+      }
+      line.Read(delay, out, size);
+      line.Write(in, size);
+      for (size_t i = 0; i < size; ++i) {
+        max_error[0] = std::max(
+            max_error[0], fabsf(out[i] - reference.Read(delay)));
+        reference.Write(in[i]);
+      }
+      ++num_blocks;
+    } else if (rand() % 4 == 0) {
+      float in = Random();
+      size_t delay = 1 + rand() % (kMaxDelay - 1);
+      max_error[1] = std::max(max_error[1], fabsf(
+          line.Allpass(in, delay, 0.6f) - reference.Allpass(in, delay, 0.6f)));
+    } else {
+      float in = Random();
+      line.Write(in);
+      reference.Write(in);
+    }
+
+    size_t delay = 1 + rand() % (kMaxDelay - 1);
+    line.set_delay(delay);
+    reference.set_delay(delay);
+    max_error[2] = std::max(
+        max_error[2], fabsf(line.Read() - reference.Read()));
+    max_error[2] = std::max(
+        max_error[2], fabsf(line.Read(delay) - reference.Read(delay)));
+    // Between 1 and kMaxDelay - 3, for the 4 points of Hermite interpolation.
+    float fractional_delay = 1.0f + (Random() + 0.5f) + rand() % (
+        kMaxDelay - 4);
+    max_error[3] = std::max(max_error[3], fabsf(
+        line.Read(fractional_delay) - reference.Read(fractional_delay)));
+    max_error[4] = std::max(max_error[4], fabsf(
+        line.ReadHermite(fractional_delay) -
+            reference.ReadHermite(fractional_delay)));
+  }
+
+  const char* names[] = {
+    "block read and write", "allpass", "integer read", "linear read",
+    "Hermite read"
+  };
+  for (size_t i = 0; i < 5; ++i) {
+    (*check)(
+        max_error[i] == 0.0f,
+        "power of two line, %s: matches DelayLine (error %g)",
+        names[i], max_error[i]);
+  }
+  (*check)(
+      num_blocks > 1000,
+      "power of two line: %d blocks", static_cast<int>(num_blocks));
+}
+
+// A DynamicDelayLine compared with a DelayLine of the same size, over the
+// whole range of valid delays, [0, max_delay).
+void TestDynamicDelayLine(CheckList* check) {
+  const size_t max_delay = 173;
+  static float buffer[max_delay];
+  static DelayLine<float, max_delay> reference;
+  DynamicDelayLine<float> line;
+  bool ok = line.Init(buffer, max_delay);
+  reference.Init();
+
+  float max_error[5] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+  for (size_t n = 0; n < 200000; ++n) {
+    float in = Random();
+    if (rand() % 4 == 0) {
+      size_t delay = rand() % max_delay;
+      max_error[0] = std::max(max_error[0], fabsf(
+          line.Allpass(in, delay, 0.6f) - reference.Allpass(in, delay, 0.6f)));
+    } else {
+      line.Write(in);
+      reference.Write(in);
+    }
+
+    size_t delay = rand() % max_delay;
+    line.set_delay(delay);
+    reference.set_delay(delay);
+    max_error[1] = std::max(
+        max_error[1], fabsf(line.Read() - reference.Read()));
+    max_error[2] = std::max(
+        max_error[2], fabsf(line.Read(delay) - reference.Read(delay)));
+    float fractional_delay = static_cast<float>(delay) + Random() + 0.5f;
+    fractional_delay = std::min(fractional_delay, max_delay - 0.001f);
+    max_error[3] = std::max(max_error[3], fabsf(
+        line.Read(fractional_delay) - reference.Read(fractional_delay)));
+    max_error[4] = std::max(max_error[4], fabsf(
+        line.ReadHermite(fractional_delay) -
+            reference.ReadHermite(fractional_delay)));
+  }
+
+  const char* names[] = {
+    "allpass", "read at the current delay", "integer read", "linear read",
+    "Hermite read"
+  };
+  for (size_t i = 0; i < 5; ++i) {
+    (*check)(
+        ok && max_error[i] == 0.0f,
+        "dynamic line, %s: matches DelayLine (error %g)",
+        names[i], max_error[i]);
+  }
+
+  static uint32_t memory[16];
+  BufferAllocator allocator(memory, sizeof(memory));
+  (*check)(
+      !line.Init(&allocator, 0) && !line.Init(buffer, 0),
+      "dynamic line: Init fails with a zero size");
+}
+
+void TestDynamicAllocation(CheckList* check) {
+  static uint32_t buffer[256];
+  BufferAllocator allocator(buffer, sizeof(buffer));
+  DynamicDelayLine<float, Q15Codec<> > line;
+  bool ok = line.Init(&allocator, 101);
+  float* next = allocator.Allocate<float>(16);
+  (*check)(
+      ok && line.max_delay() == 101 && next &&
+          (reinterpret_cast<uintptr_t>(next) & 3) == 0,
+      "dynamic Q15 line with odd max_delay keeps the allocator aligned");
+}
+
+int main(void) {
+  CheckList check;
+  srand(42);
+  for (size_t num_taps = 1; num_taps <= kMaxTaps; num_taps += 3) {
+    TestReadTaps<DELAY_LINE_INTERPOLATION_LINEAR>(
+        &check, num_taps, "linear");
+    TestReadTaps<DELAY_LINE_INTERPOLATION_HERMITE>(
+        &check, num_taps, "Hermite");
+    TestReadTaps<DELAY_LINE_INTERPOLATION_ALLPASS>(
+        &check, num_taps, "allpass");
+  }
+  TestQ15Codec<Q15Codec<> >(&check, 1.0f, "Q15");
+  TestQ15Codec<Q15Codec<2> >(&check, 4.0f, "Q15, 2 bits of headroom");
+  TestHalfFloatCodec(&check);
+  TestPowerOfTwoDelayLine(&check);
+  TestDynamicDelayLine(&check);
+  TestDynamicAllocation(&check);
+  return check.exit_code();
+}
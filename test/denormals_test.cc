@@ -0,0 +1,82 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// ScopedFlushDenormals flushes denormals for its lifetime only, and the decay
+// tail of a recursive filter reaches zero instead of lingering as denormals.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "stmlib/dsp/denormals.h"
+#include "stmlib/dsp/filter.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+// Keeps the compiler from folding the products at compile time.
+volatile float kSmall = FLT_MIN;
+volatile float kScale = 1.0e-3f;
+
+bool IsDenormal(float x) {
+  return x != 0.0f && fabsf(x) < FLT_MIN;
+}
+
+float DecayTail() {
+  OnePole lp;
+  lp.Init();
+  lp.set_f<FREQUENCY_EXACT>(0.001f);
+  float x[256];
+  std::fill(&x[0], &x[256], 0.0f);
+  x[0] = 1.0f;
+  for (size_t i = 0; i < 2000; ++i) {
+    lp.Process<FILTER_MODE_LOW_PASS>(x, 256);
+    std::fill(&x[0], &x[255], 0.0f);
+  }
+  return x[255];
+}
+
+int main(void) {
+  CheckList check;
+#if defined(__SSE__) || defined(__aarch64__)
+  check(IsDenormal(kSmall * kScale), "denormals without the guard");
+  check(IsDenormal(DecayTail()), "filter tail decays into denormals");
+  {
+    ScopedFlushDenormals flush;
+    check(kSmall * kScale == 0.0f, "denormals flushed by the guard");
+    check(DecayTail() == 0.0f, "filter tail flushed to zero");
+    {
+      ScopedFlushDenormals nested;
+    }
+    check(kSmall * kScale == 0.0f, "nested guard keeps the flags");
+  }
+  check(IsDenormal(kSmall * kScale), "flags restored after the guard");
+#else
+  ScopedFlushDenormals flush;
+  check(true, "no flush-to-zero control on this target");
+#endif  // __SSE__ || __aarch64__
+  return check.exit_code();
+}
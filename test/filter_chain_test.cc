@@ -0,0 +1,150 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Filter chain: per-sample and block processing match the stages run one
+// after the other.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "stmlib/dsp/biquad.h"
+#include "stmlib/dsp/filter.h"
+#include "stmlib/dsp/filter_chain.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+float Random() {
+  return static_cast<float>(rand()) / RAND_MAX - 0.5f;
+}
+
+typedef FilterChain<
+    FilterStage<OnePole, FILTER_MODE_HIGH_PASS>,
+    FilterStage<Svf, FILTER_MODE_LOW_PASS>,
+    BiquadCascade<2>,
+    FilterStage<NaiveSvf, FILTER_MODE_BAND_PASS> > Chain;
+
+const size_t kSize = 2048;
+
+void InitChain(Chain* chain) {
+  chain->stage<0>().Init();
+  chain->stage<0>().set_f<FREQUENCY_ACCURATE>(0.001f);
+  chain->stage<1>().Init();
+  chain->stage<1>().set_f_q<FREQUENCY_ACCURATE>(0.1f, 3.0f);
+  chain->stage<2>().Init();
+  chain->stage<2>().set_peaking(0, 0.02f, 1.0f, 6.0f);
+  chain->stage<2>().set_low_shelf(1, 0.005f, 0.707f, -3.0f);
+  chain->stage<3>().Init();
+  chain->stage<3>().set_f_q<FREQUENCY_ACCURATE>(0.05f, 2.0f);
+}
+
+// The same filters, outside of a chain.
+struct Stages {
+  void Init() {
+    one_pole.Init();
+    one_pole.set_f<FREQUENCY_ACCURATE>(0.001f);
+    svf.Init();
+    svf.set_f_q<FREQUENCY_ACCURATE>(0.1f, 3.0f);
+    biquad.Init();
+    biquad.set_peaking(0, 0.02f, 1.0f, 6.0f);
+    biquad.set_low_shelf(1, 0.005f, 0.707f, -3.0f);
+    naive_svf.Init();
+    naive_svf.set_f_q<FREQUENCY_ACCURATE>(0.05f, 2.0f);
+  }
+
+  OnePole one_pole;
+  Svf svf;
+  BiquadCascade<2> biquad;
+  NaiveSvf naive_svf;
+};
+
+void TestPerSample(CheckList* check) {
+  Chain chain;
+  Stages stages;
+  InitChain(&chain);
+  stages.Init();
+
+  float error = 0.0f;
+  for (size_t i = 0; i < kSize; ++i) {
+    float in = Random();
+    float expected = stages.one_pole.Process<FILTER_MODE_HIGH_PASS>(in);
+    expected = stages.svf.Process<FILTER_MODE_LOW_PASS>(expected);
+    expected = stages.biquad.Process(expected);
+    expected = stages.naive_svf.Process<FILTER_MODE_BAND_PASS>(expected);
+    error = std::max(error, fabsf(chain.Process(in) - expected));
+  }
+  (*check)(
+      error == 0.0f,
+      "per-sample: matches the stages chained manually (error %g)", error);
+}
+
+void TestBlock(CheckList* check) {
+  Chain chain;
+  Stages stages;
+  InitChain(&chain);
+  stages.Init();
+
+  static float in[kSize];
+  static float out[kSize];
+  static float expected[kSize];
+  for (size_t i = 0; i < kSize; ++i) {
+    in[i] = Random();
+  }
+
+  // Uneven blocks. The reference runs the block Process of each stage in
+  // turn, in place.
+  size_t done = 0;
+  size_t block_size = 1;
+  while (done < kSize) {
+    size_t size = std::min(block_size, kSize - done);
+    float* e = &expected[done];
+    chain.Process(&in[done], &out[done], size);
+    std::copy(&in[done], &in[done + size], e);
+    stages.one_pole.Process<FILTER_MODE_HIGH_PASS>(e, size);
+    stages.svf.Process<FILTER_MODE_LOW_PASS>(e, e, size);
+    stages.biquad.Process(e, e, size);
+    stages.naive_svf.Process<FILTER_MODE_BAND_PASS>(e, e, size);
+    done += size;
+    block_size = block_size * 2 + 3;
+  }
+
+  float error = 0.0f;
+  for (size_t i = 0; i < kSize; ++i) {
+    error = std::max(error, fabsf(out[i] - expected[i]));
+  }
+  (*check)(
+      error == 0.0f,
+      "block: matches the block Process of each stage (error %g)", error);
+}
+
+int main(void) {
+  CheckList check;
+  srand(42);
+  TestPerSample(&check);
+  TestBlock(&check);
+  return check.exit_code();
+}
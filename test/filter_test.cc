@@ -0,0 +1,166 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Filters: accuracy and cost of the frequency approximations, and the SVF
+// bank matches independent Svf instances.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "stmlib/dsp/filter.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+float Random() {
+  return static_cast<float>(rand()) / RAND_MAX - 0.5f;
+}
+
+const size_t kBlockSize = 37;
+const size_t kNumBlocks = 20;
+
+// Maximum relative error of g over 16Hz - 16kHz (at 48kHz), and cost of
+// Svf::set_f_q. The timing is only reported.
+template<FrequencyApproximation approximation>
+void TestFrequencyApproximation(
+    CheckList* check, const char* name, double max_error) {
+  double error = 0.0;
+  for (float f = 16.0f / 48000.0f; f < 16000.0f / 48000.0f; f *= 1.001f) {
+    double g = OnePole::tan<approximation>(f);
+    error = std::max(error, fabs(g / tan(M_PI * f) - 1.0));
+  }
+
+  const size_t size = 1024;
+  const size_t num_runs = 2000;
+  static float f[size];
+  static float q[size];
+  for (size_t i = 0; i < size; ++i) {
+    f[i] = 16.0f / 48000.0f * powf(1000.0f, static_cast<float>(i) / size);
+    q[i] = 0.5f + static_cast<float>(i % 37);
+  }
+  Svf svf;
+  svf.Init();
+  volatile float sink = 0.0f;
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (size_t run = 0; run < num_runs; ++run) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < size; ++i) {
+      svf.set_f_q<approximation>(f[i], q[i]);
+      sum += svf.h();
+    }
+    sink = sink + sum;
+  }
+  double ns = std::chrono::duration<double, std::nano>(
+      std::chrono::steady_clock::now() - start).count() / (num_runs * size);
+  (*check)(
+      error < max_error,
+      "%s: relative error of g %.2g, Svf::set_f_q %.2f ns",
+      name, error, ns);
+}
+
+template<size_t N>
+void TestSvfBank(CheckList* check, int32_t mode) {
+  const char* mode_names[] = {
+    "low-pass", "band-pass", "normalized band-pass", "high-pass", "multimode"
+  };
+  SvfBank<N> bank;
+  Svf svf[N];
+  float crossfade[N];
+  bank.Init();
+  for (size_t i = 0; i < N; ++i) {
+    float f = 0.001f * powf(2.0f, static_cast<float>(i) * 1.7f);
+    float q = 0.5f + static_cast<float>(i) * 3.0f;
+    Svf& s = svf[i];
+    s.Init();
+    s.set_f_q<FREQUENCY_ACCURATE>(f, q);
+    bank.set(i, s);
+    crossfade[i] = static_cast<float>(i) / N;
+  }
+
+  float in[kBlockSize * N];
+  float out[kBlockSize * N];
+  float channel_in[kBlockSize];
+  float channel_out[kBlockSize];
+  float error = 0.0f;
+  for (size_t block = 0; block < kNumBlocks; ++block) {
+    for (size_t i = 0; i < kBlockSize * N; ++i) {
+      in[i] = Random();
+    }
+    switch (mode) {
+      case 0: bank.template Process<FILTER_MODE_LOW_PASS>(
+          in, out, kBlockSize); break;
+      case 1: bank.template Process<FILTER_MODE_BAND_PASS>(
+          in, out, kBlockSize); break;
+      case 2: bank.template Process<FILTER_MODE_BAND_PASS_NORMALIZED>(
+          in, out, kBlockSize); break;
+      case 3: bank.template Process<FILTER_MODE_HIGH_PASS>(
+          in, out, kBlockSize); break;
+      case 4: bank.ProcessMultimode(in, out, kBlockSize, crossfade); break;
+    }
+    for (size_t i = 0; i < N; ++i) {
+      Svf& s = svf[i];
+      for (size_t n = 0; n < kBlockSize; ++n) {
+        channel_in[n] = in[n * N + i];
+      }
+      switch (mode) {
+        case 0: s.Process<FILTER_MODE_LOW_PASS>(
+            channel_in, channel_out, kBlockSize); break;
+        case 1: s.Process<FILTER_MODE_BAND_PASS>(
+            channel_in, channel_out, kBlockSize); break;
+        case 2: s.Process<FILTER_MODE_BAND_PASS_NORMALIZED>(
+            channel_in, channel_out, kBlockSize); break;
+        case 3: s.Process<FILTER_MODE_HIGH_PASS>(
+            channel_in, channel_out, kBlockSize); break;
+        case 4: s.ProcessMultimode(
+            channel_in, channel_out, kBlockSize, crossfade[i]); break;
+      }
+      for (size_t n = 0; n < kBlockSize; ++n) {
+        error = std::max(error, fabsf(out[n * N + i] - channel_out[n]));
+      }
+    }
+  }
+  (*check)(
+      error < 1e-5f,
+      "SvfBank<%d>, %s: matches Svf (error %g)",
+      static_cast<int>(N), mode_names[mode], error);
+}
+
+int main(void) {
+  CheckList check;
+  srand(42);
+  TestFrequencyApproximation<FREQUENCY_EXACT>(&check, "exact", 1e-6);
+  TestFrequencyApproximation<FREQUENCY_ACCURATE>(&check, "accurate", 0.025);
+  TestFrequencyApproximation<FREQUENCY_FAST>(&check, "fast", 0.05);
+  TestFrequencyApproximation<FREQUENCY_DIRTY>(&check, "dirty", 0.16);
+  for (int32_t mode = 0; mode < 5; ++mode) {
+    TestSvfBank<3>(&check, mode);
+    TestSvfBank<8>(&check, mode);
+  }
+  return check.exit_code();
+}
@@ -0,0 +1,117 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Fixed-point filters: SvfQ and OnePoleQ follow their floating point
+// counterparts, including with a full-scale input at high resonance.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "stmlib/dsp/dsp.h"
+#include "stmlib/dsp/filter.h"
+#include "stmlib/dsp/fixed_point_filter.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+const size_t kSize = 48000;
+
+int16_t ToQ15(float x) {
+  return Clip16(static_cast<int32_t>(lrintf(x * 32768.0f)));
+}
+
+// Full-scale sine at the cutoff frequency, where the resonant peak is the
+// highest. The reference runs at the (capped) resonance of SvfQ.
+template<FilterMode mode>
+void TestSvf(
+    CheckList* check,
+    const char* mode_name,
+    float f,
+    float resonance,
+    float reference_resonance) {
+  SvfQ svf_q;
+  Svf svf;
+  svf_q.Init();
+  svf.Init();
+  svf_q.set_f_q<FREQUENCY_DIRTY>(f, resonance);
+  svf.set_f_q<FREQUENCY_DIRTY>(f, reference_resonance);
+
+  int32_t error = 0;
+  for (size_t i = 0; i < kSize; ++i) {
+    int16_t in = ToQ15(
+        32767.0f / 32768.0f * sinf(2.0f * float(M_PI) * f * i));
+    float expected = svf.Process<mode>(static_cast<float>(in) / 32768.0f);
+    int32_t out = svf_q.Process<mode>(in);
+    error = std::max(error, abs(out - ToQ15(expected)));
+  }
+  (*check)(
+      error <= 8,
+      "SvfQ, %s, f = %g, resonance %g: matches Svf (error %d LSB)",
+      mode_name, f, resonance, error);
+}
+
+template<FilterMode mode>
+void TestOnePole(CheckList* check, const char* mode_name, float f) {
+  OnePoleQ one_pole_q;
+  OnePole one_pole;
+  one_pole_q.Init();
+  one_pole.Init();
+  one_pole_q.set_f<FREQUENCY_DIRTY>(f);
+  one_pole.set_f<FREQUENCY_DIRTY>(f);
+
+  int32_t error = 0;
+  for (size_t i = 0; i < kSize; ++i) {
+    int16_t in = ToQ15(
+        static_cast<float>(rand()) / RAND_MAX * 2.0f - 1.0f);
+    float expected = one_pole.Process<mode>(static_cast<float>(in) / 32768.0f);
+    int32_t out = one_pole_q.Process<mode>(in);
+    error = std::max(error, abs(out - ToQ15(expected)));
+  }
+  (*check)(
+      error <= 2,
+      "OnePoleQ, %s, f = %g: matches OnePole (error %d LSB)",
+      mode_name, f, error);
+}
+
+int main(void) {
+  CheckList check;
+  srand(42);
+  const float frequencies[] = { 0.001f, 0.01f, 0.1f, 0.25f, 0.45f };
+  for (size_t i = 0; i < sizeof(frequencies) / sizeof(float); ++i) {
+    float f = frequencies[i];
+    TestSvf<FILTER_MODE_LOW_PASS>(&check, "low-pass", f, 0.7f, 0.7f);
+    TestSvf<FILTER_MODE_LOW_PASS>(&check, "low-pass", f, 8.0f, 8.0f);
+    TestSvf<FILTER_MODE_LOW_PASS>(&check, "low-pass", f, 100.0f, 8.0f);
+    TestSvf<FILTER_MODE_BAND_PASS>(&check, "band-pass", f, 100.0f, 8.0f);
+    TestSvf<FILTER_MODE_BAND_PASS_NORMALIZED>(
+        &check, "normalized band-pass", f, 100.0f, 8.0f);
+    TestSvf<FILTER_MODE_HIGH_PASS>(&check, "high-pass", f, 100.0f, 8.0f);
+    TestOnePole<FILTER_MODE_LOW_PASS>(&check, "low-pass", f);
+    TestOnePole<FILTER_MODE_HIGH_PASS>(&check, "high-pass", f);
+  }
+  return check.exit_code();
+}
@@ -0,0 +1,154 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// FxEngine: delay line addressing, reads, writes and allpass sections against
+// a plain history of the written samples, with 32-bit and 16-bit storage, and
+// rounding and clipping of the 16-bit storage.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "stmlib/dsp/fx_engine.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+float Random() {
+  return static_cast<float>(rand()) / RAND_MAX - 0.5f;
+}
+
+const size_t kNumSamples = 10000;
+
+template<FxEngineFormat format>
+void TestEngine(CheckList* check, const char* name) {
+  typedef FxEngine<4096, format> E;
+  typedef FxEngineDataType<format> DataType;
+  typedef typename E::template Reserve<113,
+      typename E::template Reserve<1559,
+      typename E::template Reserve<1973> > > Memory;
+  typename E::template DelayLine<Memory, 0> ap;
+  typename E::template DelayLine<Memory, 1> del_1;
+  typename E::template DelayLine<Memory, 2> del_2;
+
+  (*check)(
+      ap.base == 0 && ap.length == 113 &&
+          del_1.base == 114 && del_1.length == 1559 &&
+          del_2.base == 114 + 1560 && del_2.length == 1973,
+      "%s: lines are laid out one after the other", name);
+
+  static typename E::T buffer[4096];
+  static E engine;
+  engine.Init(buffer);
+
+  // History of the values written to each line, as stored.
+  std::vector<float> ap_history;
+  std::vector<float> del_1_history;
+  std::vector<float> del_2_history;
+
+  float read_error = 0.0f;
+  float allpass_error = 0.0f;
+  const float g = 0.625f;
+  for (size_t n = 0; n < kNumSamples; ++n) {
+    typename E::Context c;
+    engine.Start(&c);
+    float x = Random();
+
+    // Allpass section on the whole length of the first line.
+    float r = n >= ap.length - 1 ? ap_history[n - (ap.length - 1)] : 0.0f;
+    float v = x + r * g;
+    float expected = v * -g + r;
+    ap_history.push_back(DataType::Decompress(DataType::Compress(v)));
+    c.Load(x);
+    c.Allpass(ap, g);
+    float y;
+    c.Write(y);
+    allpass_error = std::max(allpass_error, fabsf(y - expected));
+
+    // Plain writes to the heads of the two other lines, reads at a random
+    // offset and at the tail.
+    c.Load(x);
+    c.Write(del_1, 0.0f);
+    del_1_history.push_back(DataType::Decompress(DataType::Compress(x)));
+    c.Load(-x);
+    c.Write(del_2, 0.0f);
+    del_2_history.push_back(DataType::Decompress(DataType::Compress(-x)));
+
+    int32_t offset = rand() % del_1.length;
+    float read;
+    c.Load(0.0f);
+    c.Read(del_1, offset, 1.0f);
+    c.Write(read);
+    expected = static_cast<size_t>(offset) <= n
+        ? del_1_history[n - offset]
+        : 0.0f;
+    read_error = std::max(read_error, fabsf(read - expected));
+
+    c.Load(0.0f);
+    c.Read(del_2, E::tail, 0.5f);
+    c.Write(read);
+    expected = n >= del_2.length - 1
+        ? 0.5f * del_2_history[n - (del_2.length - 1)]
+        : 0.0f;
+    read_error = std::max(read_error, fabsf(read - expected));
+  }
+  (*check)(
+      read_error == 0.0f,
+      "%s: reads return the samples written offset samples ago (error %g)",
+      name, read_error);
+  (*check)(
+      allpass_error == 0.0f,
+      "%s: allpass matches the direct form (error %g)", name, allpass_error);
+}
+
+void TestCompress(CheckList* check) {
+  typedef FxEngineDataType<FX_ENGINE_FORMAT_16_BIT> DataType;
+  float max_error = 0.0f;
+  for (int32_t i = -3 * 32768; i < 3 * 32768; ++i) {
+    float x = static_cast<float>(i) / 65536.0f * 1.37f;
+    float clipped = std::max(-1.0f, std::min(x, 32767.0f / 32768.0f));
+    float error = fabsf(DataType::Decompress(DataType::Compress(x)) - clipped);
+    max_error = std::max(max_error, error * 32768.0f);
+  }
+  (*check)(
+      max_error <= 0.5f,
+      "16-bit: error within half a step (%g steps)", max_error);
+  (*check)(
+      DataType::Compress(1.0e10f) == 32767 &&
+          DataType::Compress(-1.0e10f) == -32768 &&
+          DataType::Compress(nanf("")) == -32768,
+      "16-bit: clipped out of range");
+}
+
+int main(void) {
+  CheckList check;
+  srand(42);
+  TestEngine<FX_ENGINE_FORMAT_32_BIT>(&check, "32-bit");
+  TestEngine<FX_ENGINE_FORMAT_16_BIT>(&check, "16-bit");
+  TestCompress(&check);
+  return check.exit_code();
+}
@@ -0,0 +1,152 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Oversampled processor: the output does not depend on max_size, unity gain
+// at DC through an identity processor, and Process terminates (with silence)
+// when Init failed or was not called.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "stmlib/dsp/oversampled.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+float Random() {
+  return static_cast<float>(rand()) / RAND_MAX - 0.5f;
+}
+
+struct Identity {
+  void Process(const float* in, float* out, size_t size) {
+    std::copy(&in[0], &in[size], &out[0]);
+  }
+};
+
+struct Saturation {
+  void Process(const float* in, float* out, size_t size) {
+    while (size--) {
+      *out++ = tanhf(4.0f * *in++);
+    }
+  }
+};
+
+const int32_t kRatio = 4;
+const int32_t kFilterSize = 48;
+const size_t kSize = 1000;
+
+template<typename Processor>
+void TestMaxSize(CheckList* check, const char* name) {
+  static float scratch_large[kSize * kRatio];
+  static float scratch_small[7 * kRatio];
+  Oversampled<Processor, kRatio, kFilterSize> large;
+  Oversampled<Processor, kRatio, kFilterSize> small;
+  large.Init(scratch_large, kSize);
+  small.Init(scratch_small, 7);
+
+  static float in[kSize];
+  static float out_large[kSize];
+  static float out_small[kSize];
+  for (size_t i = 0; i < kSize; ++i) {
+    in[i] = Random();
+  }
+  large.Process(in, out_large, kSize);
+
+  // Uneven blocks, in place.
+  std::copy(&in[0], &in[kSize], &out_small[0]);
+  size_t done = 0;
+  size_t block_size = 1;
+  while (done < kSize) {
+    size_t size = std::min(block_size, kSize - done);
+    small.Process(&out_small[done], &out_small[done], size);
+    done += size;
+    block_size += 5;
+  }
+  (*check)(
+      std::equal(&out_large[0], &out_large[kSize], &out_small[0]),
+      "%s: output does not depend on max_size and block size", name);
+}
+
+void TestDCGain(CheckList* check) {
+  static float scratch[64 * kRatio];
+  Oversampled<Identity, kRatio, kFilterSize> oversampled;
+  oversampled.Init(scratch, 64);
+
+  static float in[kSize];
+  static float out[kSize];
+  std::fill(&in[0], &in[kSize], 0.5f);
+  oversampled.Process(in, out, kSize);
+  float error = 0.0f;
+  for (size_t i = kSize / 2; i < kSize; ++i) {
+    error = std::max(error, fabsf(out[i] - 0.5f));
+  }
+  (*check)(error < 1e-3f, "identity: unity gain at DC (error %g)", error);
+}
+
+void TestInvalidInit(CheckList* check) {
+  static float scratch[16 * kRatio];
+  char buffer[256];
+  BufferAllocator allocator(buffer, sizeof(buffer));
+
+  static float in[16];
+  static float out[16];
+  for (size_t i = 0; i < 16; ++i) {
+    in[i] = 1.0f;
+    out[i] = 1.0f;
+  }
+
+  Oversampled<Identity, kRatio, kFilterSize> uninitialized;
+  uninitialized.Process(in, out, 16);
+  (*check)(
+      out[0] == 0.0f && out[15] == 0.0f,
+      "Process without Init outputs silence");
+
+  Oversampled<Identity, kRatio, kFilterSize> oversampled;
+  (*check)(!oversampled.Init(scratch, 0), "Init fails with max_size = 0");
+  (*check)(
+      !oversampled.Init(&allocator, 0),
+      "Init fails with max_size = 0 (allocator)");
+  (*check)(
+      !oversampled.Init(&allocator, 1024),
+      "Init fails when the allocator is full");
+  std::fill(&out[0], &out[16], 1.0f);
+  oversampled.Process(in, out, 16);
+  (*check)(
+      out[0] == 0.0f && out[15] == 0.0f,
+      "Process after a failed Init outputs silence");
+  (*check)(oversampled.Init(&allocator, 16), "Init succeeds");
+}
+
+int main(void) {
+  CheckList check;
+  srand(42);
+  TestMaxSize<Identity>(&check, "identity");
+  TestMaxSize<Saturation>(&check, "saturation");
+  TestDCGain(&check);
+  TestInvalidInit(&check);
+  return check.exit_code();
+}
@@ -0,0 +1,141 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Partitioned convolver: the output matches a direct convolution delayed by
+// the latency, for impulse responses of various lengths (including ones
+// truncated to max_ir_size) and any input block size.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "stmlib/fft/partitioned_convolver.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+float Random() {
+  return static_cast<float>(rand()) / RAND_MAX - 0.5f;
+}
+
+const size_t kSize = 8192;
+const size_t kMaxIrSize = 1000;
+
+float memory[8192];
+
+template<size_t block_size>
+void TestConvolution(CheckList* check, size_t ir_size, size_t io_block_size) {
+  typedef PartitionedConvolver<block_size> Convolver;
+  static typename Convolver::FFT fft;
+  BufferAllocator allocator(memory, sizeof(memory));
+  Convolver convolver;
+  fft.Init();
+  convolver.Init(&fft, &allocator, kMaxIrSize);
+
+  static float ir[2 * kMaxIrSize];
+  static float in[kSize];
+  static float out[kSize];
+  for (size_t i = 0; i < ir_size; ++i) {
+    ir[i] = Random() * expf(-4.0f * i / ir_size);
+  }
+  for (size_t i = 0; i < kSize; ++i) {
+    in[i] = Random();
+  }
+  convolver.set_impulse_response(ir, ir_size);
+
+  // io_block_size = 0 stands for random block sizes. Processed in place.
+  std::copy(&in[0], &in[kSize], &out[0]);
+  size_t done = 0;
+  while (done < kSize) {
+    size_t size = io_block_size
+        ? io_block_size
+        : rand() % (3 * block_size) + 1;
+    size = std::min(size, kSize - done);
+    convolver.Process(&out[done], &out[done], size);
+    done += size;
+  }
+
+  const size_t latency = Convolver::latency;
+  const size_t truncated_ir_size = std::min(
+      ir_size,
+      Convolver::num_partitions(kMaxIrSize) * block_size);
+  double error = 0.0;
+  for (size_t n = 0; n < kSize; ++n) {
+    double expected = 0.0;
+    for (size_t k = 0; k < truncated_ir_size && k + latency <= n; ++k) {
+      expected += ir[k] * in[n - latency - k];
+    }
+    error = std::max(error, fabs(out[n] - expected));
+  }
+  char blocks[32];
+  if (io_block_size) {
+    snprintf(
+        blocks, sizeof(blocks), "I/O blocks of %d",
+        static_cast<int>(io_block_size));
+  } else {
+    snprintf(blocks, sizeof(blocks), "random I/O blocks");
+  }
+  (*check)(
+      error < 1e-4,
+      "block size %d, %d samples IR, %s: matches convolution (error %g)",
+      static_cast<int>(block_size), static_cast<int>(ir_size), blocks, error);
+}
+
+void TestSilence(CheckList* check) {
+  typedef PartitionedConvolver<64> Convolver;
+  static Convolver::FFT fft;
+  BufferAllocator allocator(memory, sizeof(memory));
+  Convolver convolver;
+  fft.Init();
+  convolver.Init(&fft, &allocator, kMaxIrSize);
+
+  static float in[kSize];
+  static float out[kSize];
+  for (size_t i = 0; i < kSize; ++i) {
+    in[i] = Random();
+  }
+  convolver.Process(in, out, kSize);
+  float peak = 0.0f;
+  for (size_t i = 0; i < kSize; ++i) {
+    peak = std::max(peak, fabsf(out[i]));
+  }
+  (*check)(peak == 0.0f, "no impulse response: silence");
+}
+
+int main(void) {
+  CheckList check;
+  srand(42);
+  const size_t ir_sizes[] = { 1, 63, 64, 65, 300, kMaxIrSize, 2 * kMaxIrSize };
+  for (size_t i = 0; i < sizeof(ir_sizes) / sizeof(size_t); ++i) {
+    TestConvolution<64>(&check, ir_sizes[i], 0);
+    TestConvolution<64>(&check, ir_sizes[i], 64);
+    TestConvolution<256>(&check, ir_sizes[i], 1);
+    TestConvolution<256>(&check, ir_sizes[i], 0);
+  }
+  TestSilence(&check);
+  return check.exit_code();
+}
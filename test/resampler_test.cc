@@ -0,0 +1,123 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Resampler: number of output samples and DC gain over a sweep of ratios,
+// independence from the block size, and termination with invalid ratios.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "stmlib/dsp/resampler.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+float Random() {
+  return static_cast<float>(rand()) / RAND_MAX - 0.5f;
+}
+
+const size_t kNumTaps = 16;
+
+typedef Resampler<kNumTaps, 64> TestResampler;
+
+const size_t kSize = 4000;
+const size_t kMaxOutputSize = kSize * 256 + 1;
+
+float table[TestResampler::TABLE_SIZE];
+float in[kSize];
+float out[kMaxOutputSize];
+float out_blocks[kMaxOutputSize];
+
+void TestRatio(CheckList* check, float ratio) {
+  TestResampler resampler;
+  resampler.Init(table);
+  resampler.set_ratio(ratio);
+
+  std::fill(&in[0], &in[kSize], 0.5f);
+  size_t n = resampler.Process(in, out, kSize);
+
+  // Output sample k is read at input position k * ratio.
+  size_t expected_n = static_cast<size_t>(ceil(kSize / ratio));
+  float error = 0.0f;
+  // The history is full after kNumTaps input samples.
+  size_t settled = static_cast<size_t>((kNumTaps + 1) / ratio) + 1;
+  for (size_t i = settled; i < n; ++i) {
+    error = std::max(error, fabsf(out[i] - 0.5f));
+  }
+  (*check)(
+      n + 1 >= expected_n && n <= expected_n + 1,
+      "ratio %g: %d outputs for %d inputs (expected %d)",
+      ratio, static_cast<int>(n), static_cast<int>(kSize),
+      static_cast<int>(expected_n));
+  (*check)(
+      error < 1e-5f, "ratio %g: unity gain at DC (error %g)", ratio, error);
+
+  // Same output when the input is split in uneven blocks.
+  for (size_t i = 0; i < kSize; ++i) {
+    in[i] = Random();
+  }
+  resampler.Reset();
+  n = resampler.Process(in, out, kSize);
+  resampler.Reset();
+  size_t n_blocks = 0;
+  size_t done = 0;
+  size_t block_size = 1;
+  while (done < kSize) {
+    size_t size = std::min(block_size, kSize - done);
+    n_blocks += resampler.Process(&in[done], &out_blocks[n_blocks], size);
+    done += size;
+    block_size += 7;
+  }
+  (*check)(
+      n_blocks == n && std::equal(&out[0], &out[n], &out_blocks[0]),
+      "ratio %g: output does not depend on the block size", ratio);
+}
+
+void TestInvalidRatio(CheckList* check, float ratio) {
+  TestResampler resampler;
+  resampler.Init(table);
+  resampler.set_ratio(ratio);
+  size_t n = resampler.Process(in, out, kSize);
+  (*check)(
+      n <= kMaxOutputSize,
+      "ratio %g: clamped (%d outputs)", ratio, static_cast<int>(n));
+}
+
+int main(void) {
+  CheckList check;
+  srand(42);
+  TestResampler::Design(0.9f, table);
+
+  const float ratios[] = { 0.1f, 0.25f, 0.5f, 0.9f, 1.0f, 1.37f, 2.0f, 4.0f };
+  for (size_t i = 0; i < sizeof(ratios) / sizeof(float); ++i) {
+    TestRatio(&check, ratios[i]);
+  }
+  TestInvalidRatio(&check, 0.0f);
+  TestInvalidRatio(&check, -1.0f);
+  TestInvalidRatio(&check, nanf(""));
+  return check.exit_code();
+}
@@ -0,0 +1,341 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// SRC_DOWN converters: the output does not depend on how the input is split
+// into blocks, and matches a direct convolution evaluated at the last sample
+// of each group of "ratio" input samples. SRC_UP converters match a direct
+// convolution of the zero-stuffed input. The same is checked for the
+// half-band converters, with their default Kaiser designs.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "stmlib/dsp/sample_rate_converter.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+const int32_t kRatio = 4;
+const int32_t kFilterSize = 32;
+const size_t kSize = 4096;
+
+// Only the first half of a symmetric filter is read.
+const float kTaps[kFilterSize / 2] = {
+  -0.0011f, -0.0021f, -0.0027f, -0.0019f, 0.0013f, 0.0071f, 0.0140f, 0.0188f,
+  0.0170f, 0.0047f, -0.0185f, -0.0476f, -0.0719f, -0.0724f, -0.0273f, 0.1233f
+};
+
+namespace stmlib {
+
+template<>
+struct SRC_FIR<SRC_DOWN, kRatio, kFilterSize> {
+  template<int32_t i> inline float Read() const {
+    return kTaps[i];
+  }
+};
+
+// The mono SRC_UP converter reads the whole filter, the multichannel one only
+// its first half.
+template<>
+struct SRC_FIR<SRC_UP, kRatio, kFilterSize> {
+  template<int32_t i> inline float Read() const {
+    return i < kFilterSize / 2 ? kTaps[i] : kTaps[kFilterSize - 1 - i];
+  }
+};
+
+}  // namespace stmlib
+
+float Tap(int32_t i) {
+  return i < kFilterSize / 2 ? kTaps[i] : kTaps[kFilterSize - 1 - i];
+}
+
+double Reference(const float* x, size_t m, int32_t channel, int32_t stride) {
+  double sum = 0.0;
+  for (int32_t k = 0; k < kFilterSize; ++k) {
+    int32_t n = static_cast<int32_t>(m) * kRatio + kRatio - 1 - k;
+    if (n >= 0) {
+      sum += x[n * stride + channel] * Tap(k);
+    }
+  }
+  return sum;
+}
+
+// Output sample m of the interpolator, input sample n being at m = n * ratio.
+double ReferenceUp(const float* x, size_t m, int32_t channel, int32_t stride) {
+  double sum = 0.0;
+  for (int32_t k = 0; k < kFilterSize; ++k) {
+    int32_t n = static_cast<int32_t>(m) - k;
+    if (n >= 0 && n % kRatio == 0) {
+      sum += x[n / kRatio * stride + channel] * Tap(k);
+    }
+  }
+  return sum;
+}
+
+size_t RandomBlockSize(size_t remaining) {
+  size_t size = rand() % 70;
+  return size < remaining ? size : remaining;
+}
+
+void TestMono(CheckList* check) {
+  static float in[kSize];
+  static float out[kSize / kRatio + 1];
+  static float out_block[kSize / kRatio + 1];
+  for (size_t i = 0; i < kSize; ++i) {
+    in[i] = static_cast<float>(rand()) / RAND_MAX - 0.5f;
+  }
+
+  SampleRateConverter<SRC_DOWN, kRatio, kFilterSize> src;
+  src.Init();
+  size_t n = src.Process(in, out, kSize);
+  (*check)(n == kSize / kRatio, "%d outputs in one block", (int) n);
+
+  double max_error = 0.0;
+  for (size_t m = 0; m < n; ++m) {
+    max_error = std::max(max_error, fabs(out[m] - Reference(in, m, 0, 1)));
+  }
+  (*check)(max_error < 1e-6, "matches convolution (error %g)", max_error);
+
+  src.Init();
+  size_t done = 0;
+  size_t num_outputs = 0;
+  while (done < kSize) {
+    size_t size = RandomBlockSize(kSize - done);
+    num_outputs += src.Process(&in[done], &out_block[num_outputs], size);
+    done += size;
+  }
+  (*check)(
+      num_outputs == n && std::equal(&out[0], &out[n], &out_block[0]),
+      "random block sizes give the same output");
+}
+
+void TestMultiChannel(CheckList* check) {
+  const int32_t num_channels = 3;
+  static float in[kSize * num_channels];
+  static float out[(kSize / kRatio + 1) * num_channels];
+  static float out_block[(kSize / kRatio + 1) * num_channels];
+  for (size_t i = 0; i < kSize * num_channels; ++i) {
+    in[i] = static_cast<float>(rand()) / RAND_MAX - 0.5f;
+  }
+
+  MultiChannelSampleRateConverter<
+      SRC_DOWN, kRatio, kFilterSize, num_channels> src;
+  src.Init();
+  size_t n = src.Process(in, out, kSize);
+  (*check)(n == kSize / kRatio, "%d multichannel outputs", (int) n);
+
+  double max_error = 0.0;
+  for (size_t m = 0; m < n; ++m) {
+    for (int32_t c = 0; c < num_channels; ++c) {
+      double error = fabs(
+          out[m * num_channels + c] - Reference(in, m, c, num_channels));
+      max_error = std::max(max_error, error);
+    }
+  }
+  (*check)(max_error < 1e-6, "multichannel matches convolution (error %g)",
+           max_error);
+
+  src.Init();
+  size_t done = 0;
+  size_t num_outputs = 0;
+  while (done < kSize) {
+    size_t size = RandomBlockSize(kSize - done);
+    num_outputs += src.Process(
+        &in[done * num_channels],
+        &out_block[num_outputs * num_channels],
+        size);
+    done += size;
+  }
+  (*check)(
+      num_outputs == n && std::equal(
+          &out[0], &out[n * num_channels], &out_block[0]),
+      "multichannel, random block sizes give the same output");
+}
+
+template<int32_t num_channels, typename Converter>
+void TestUp(CheckList* check, const char* name) {
+  static float in[kSize * num_channels];
+  static float out[kSize * kRatio * num_channels];
+  static float out_block[kSize * kRatio * num_channels];
+  for (size_t i = 0; i < kSize * num_channels; ++i) {
+    in[i] = static_cast<float>(rand()) / RAND_MAX - 0.5f;
+  }
+
+  Converter src;
+  src.Init();
+  src.Process(in, out, kSize);
+
+  double max_error = 0.0;
+  for (size_t m = 0; m < kSize * kRatio; ++m) {
+    for (int32_t c = 0; c < num_channels; ++c) {
+      double error = fabs(
+          out[m * num_channels + c] - ReferenceUp(in, m, c, num_channels));
+      max_error = std::max(max_error, error);
+    }
+  }
+  (*check)(max_error < 1e-6, "%s: matches convolution (error %g)",
+           name, max_error);
+
+  src.Init();
+  size_t done = 0;
+  while (done < kSize) {
+    size_t size = RandomBlockSize(kSize - done);
+    src.Process(
+        &in[done * num_channels],
+        &out_block[done * kRatio * num_channels],
+        size);
+    done += size;
+  }
+  (*check)(
+      std::equal(
+          &out[0], &out[kSize * kRatio * num_channels], &out_block[0]),
+      "%s: random block sizes give the same output", name);
+}
+
+// Expands the M distinct coefficients of a half-band filter into its
+// num_taps taps.
+template<int32_t num_taps, int32_t k = (num_taps + 1) / 4 - 1>
+struct HalfBandTaps {
+  static void Fill(float* h) {
+    SRC_HALF_BAND_FIR<num_taps> ir;
+    HalfBandTaps<num_taps, k - 1>::Fill(h);
+    h[num_taps / 2 - 2 * k - 1] = ir.template Read<k>();
+    h[num_taps / 2 + 2 * k + 1] = ir.template Read<k>();
+  }
+};
+
+template<int32_t num_taps>
+struct HalfBandTaps<num_taps, -1> {
+  static void Fill(float* h) {
+    std::fill(&h[0], &h[num_taps], 0.0f);
+    h[num_taps / 2] = 0.5f;
+  }
+};
+
+// Direct convolution with the full filter. For the interpolator, the input is
+// zero-stuffed and the output scaled by 2.
+double ReferenceHalfBand(
+    const float* x, const float* h, int32_t num_taps, int32_t n, bool up) {
+  double sum = 0.0;
+  for (int32_t k = 0; k < num_taps; ++k) {
+    int32_t m = n - k;
+    if (up) {
+      sum += m >= 0 && m % 2 == 0 ? 2.0 * x[m / 2] * h[k] : 0.0;
+    } else {
+      sum += m >= 0 ? x[m] * h[k] : 0.0;
+    }
+  }
+  return sum;
+}
+
+template<int32_t num_taps>
+void TestHalfBand(CheckList* check) {
+  static float in[kSize];
+  static float out[2 * kSize];
+  static float out_block[2 * kSize];
+  float h[num_taps];
+  HalfBandTaps<num_taps>::Fill(h);
+  for (size_t i = 0; i < kSize; ++i) {
+    in[i] = static_cast<float>(rand()) / RAND_MAX - 0.5f;
+  }
+
+  double sum = 0.0;
+  for (int32_t k = 0; k < num_taps; ++k) {
+    sum += h[k];
+  }
+  (*check)(
+      fabs(sum - 1.0) < 1e-6,
+      "half band, %d taps: unity gain at DC (%g)", num_taps, sum);
+
+  HalfBandSampleRateConverter<SRC_UP, num_taps> up;
+  up.Init();
+  up.Process(in, out, kSize);
+  double max_error = 0.0;
+  for (size_t n = 0; n < 2 * kSize; ++n) {
+    double error = fabs(out[n] - ReferenceHalfBand(in, h, num_taps, n, true));
+    max_error = std::max(max_error, error);
+  }
+  (*check)(
+      max_error < 1e-6,
+      "half band up, %d taps: matches convolution (error %g)",
+      num_taps, max_error);
+
+  up.Init();
+  size_t done = 0;
+  while (done < kSize) {
+    size_t size = RandomBlockSize(kSize - done);
+    up.Process(&in[done], &out_block[2 * done], size);
+    done += size;
+  }
+  (*check)(
+      std::equal(&out[0], &out[2 * kSize], &out_block[0]),
+      "half band up, %d taps: random block sizes give the same output",
+      num_taps);
+
+  HalfBandSampleRateConverter<SRC_DOWN, num_taps> down;
+  down.Init();
+  size_t n = down.Process(in, out, kSize);
+  max_error = 0.0;
+  for (size_t m = 0; m < n; ++m) {
+    // Outputs are computed at odd input samples.
+    double error = fabs(
+        out[m] - ReferenceHalfBand(in, h, num_taps, 2 * m + 1, false));
+    max_error = std::max(max_error, error);
+  }
+  (*check)(
+      n == kSize / 2 && max_error < 1e-6,
+      "half band down, %d taps: %d outputs, matches convolution (error %g)",
+      num_taps, static_cast<int>(n), max_error);
+
+  down.Init();
+  done = 0;
+  size_t num_outputs = 0;
+  while (done < kSize) {
+    size_t size = RandomBlockSize(kSize - done);
+    num_outputs += down.Process(&in[done], &out_block[num_outputs], size);
+    done += size;
+  }
+  (*check)(
+      num_outputs == n && std::equal(&out[0], &out[n], &out_block[0]),
+      "half band down, %d taps: random block sizes give the same output",
+      num_taps);
+}
+
+int main(void) {
+  CheckList check;
+  srand(42);
+  TestMono(&check);
+  TestMultiChannel(&check);
+  TestUp<1, SampleRateConverter<SRC_UP, kRatio, kFilterSize> >(
+      &check, "up");
+  TestUp<3, MultiChannelSampleRateConverter<
+      SRC_UP, kRatio, kFilterSize, 3> >(&check, "multichannel up");
+  TestHalfBand<7>(&check);
+  TestHalfBand<15>(&check);
+  TestHalfBand<31>(&check);
+  return check.exit_code();
+}
@@ -0,0 +1,236 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// ShyFFT: batched transforms match individual transforms, transforms beyond
+// the size of the bit-reversal tables match a direct DFT, and the fixed point
+// transforms do not overflow on full scale inputs.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "stmlib/fft/shy_fft.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+float Random() {
+  return static_cast<float>(rand()) / RAND_MAX - 0.5f;
+}
+
+template<size_t size, size_t num_transforms>
+void TestBatch(CheckList* check) {
+  static ShyFFT<float, size> fft;
+  fft.Init();
+
+  static float x[size * num_transforms];
+  static float y[size * num_transforms];
+  static float z[size * num_transforms];
+  static float buffer[size];
+  static float reference[num_transforms][size];
+  for (size_t i = 0; i < size * num_transforms; ++i) {
+    x[i] = Random();
+  }
+  for (size_t k = 0; k < num_transforms; ++k) {
+    for (size_t i = 0; i < size; ++i) {
+      buffer[i] = x[i * num_transforms + k];
+    }
+    fft.Direct(buffer, reference[k]);
+  }
+
+  std::copy(&x[0], &x[size * num_transforms], &z[0]);
+  fft.template DirectBatch<num_transforms>(z, y);
+  float error = 0.0f;
+  for (size_t k = 0; k < num_transforms; ++k) {
+    for (size_t i = 0; i < size; ++i) {
+      error = std::max(
+          error, fabsf(y[i * num_transforms + k] - reference[k][i]));
+    }
+  }
+  (*check)(
+      error < 1e-4f,
+      "%d x %d points: batch matches single transforms (error %g)",
+      static_cast<int>(num_transforms), static_cast<int>(size), error);
+
+  fft.template InverseBatch<num_transforms>(y, z);
+  error = 0.0f;
+  for (size_t i = 0; i < size * num_transforms; ++i) {
+    error = std::max(error, fabsf(z[i] / size - x[i]));
+  }
+  (*check)(
+      error < 1e-5f,
+      "%d x %d points: batch round trip (error %g)",
+      static_cast<int>(num_transforms), static_cast<int>(size), error);
+}
+
+void TestBitReversedIncrement(CheckList* check) {
+  const size_t num_bits = 18;
+  size_t r = 0;
+  bool ok = true;
+  for (size_t i = 1; i < (1 << num_bits); ++i) {
+    r = BitReversedIncrement(r, 1 << (num_bits - 1));
+    size_t expected = 0;
+    for (size_t b = 0; b < num_bits; ++b) {
+      expected |= ((i >> b) & 1) << (num_bits - 1 - b);
+    }
+    ok = ok && r == expected;
+  }
+  (*check)(ok, "bit-reversed counter on %d bits", static_cast<int>(num_bits));
+}
+
+// Compares a subset of the bins with a direct DFT, in the FFTReal layout:
+// real part of bin k at k, imaginary part (with opposite sign) at N/2 + k.
+template<size_t size>
+void TestAgainstDft(CheckList* check) {
+  static ShyFFT<float, size> fft;
+  fft.Init();
+  static float x[size];
+  static float in[size];
+  static float y[size];
+  for (size_t i = 0; i < size; ++i) {
+    x[i] = in[i] = Random();
+  }
+  fft.Direct(in, y);
+
+  double error = 0.0;
+  double peak = 0.0;
+  for (size_t k = 0; k <= size / 2; k += size / 64 + 1) {
+    double re = 0.0;
+    double im = 0.0;
+    for (size_t n = 0; n < size; ++n) {
+      double phase = 2.0 * M_PI * static_cast<double>((k * n) % size) / size;
+      re += x[n] * cos(phase);
+      im += x[n] * sin(phase);
+    }
+    peak = std::max(peak, sqrt(re * re + im * im));
+    error = std::max(error, fabs(re - y[k]));
+    if (k > 0 && k < size / 2) {
+      error = std::max(error, fabs(im - y[size / 2 + k]));
+    }
+  }
+  (*check)(
+      error < peak * 1e-5,
+      "%d points: matches DFT (relative error %g)",
+      static_cast<int>(size), error / peak);
+}
+
+template<typename T> struct FullScale { };
+template<> struct FullScale<int16_t> {
+  static double value() { return 32768.0; }
+};
+template<> struct FullScale<int32_t> {
+  static double value() { return 2147483648.0; }
+};
+
+// Runs the fixed point transform (and its inverse) on x, in [-1, 1), and
+// returns the SNR in dB relative to the double precision transform.
+template<typename T, size_t size>
+double FixedPointSnr(const double* x, bool inverse) {
+  static ShyFFT<T, size> fft;
+  static ShyFFT<double, size> reference;
+  fft.Init();
+  reference.Init();
+
+  static T x_fixed[size];
+  static T y_fixed[size];
+  static double x_reference[size];
+  static double y_reference[size];
+  for (size_t i = 0; i < size; ++i) {
+    double v = floor(x[i] * FullScale<T>::value() + 0.5);
+    v = std::min(v, FullScale<T>::value() - 1.0);
+    x_fixed[i] = static_cast<T>(v);
+    x_reference[i] = v / FullScale<T>::value();
+  }
+  int32_t exponent;
+  if (inverse) {
+    exponent = fft.Inverse(x_fixed, y_fixed);
+    reference.Inverse(x_reference, y_reference);
+  } else {
+    exponent = fft.Direct(x_fixed, y_fixed);
+    reference.Direct(x_reference, y_reference);
+  }
+
+  double signal = 0.0;
+  double noise = 0.0;
+  for (size_t i = 0; i < size; ++i) {
+    double y = ldexp(static_cast<double>(y_fixed[i]), exponent) /
+        FullScale<T>::value();
+    signal += y_reference[i] * y_reference[i];
+    noise += (y - y_reference[i]) * (y - y_reference[i]);
+  }
+  return noise == 0.0 ? 1000.0 : 10.0 * log10(signal / noise);
+}
+
+template<typename T, size_t size>
+void TestFixedPoint(CheckList* check, const char* name, double min_snr) {
+  static double x[size];
+  const char* labels[] = {
+    "+DC", "-DC", "alternating", "noise", "-40dB noise"
+  };
+  for (int32_t signal = 0; signal < 5; ++signal) {
+    for (size_t i = 0; i < size; ++i) {
+      switch (signal) {
+        case 0: x[i] = 1.0; break;
+        case 1: x[i] = -1.0; break;
+        case 2: x[i] = i & 1 ? -1.0 : 1.0; break;
+        case 3: x[i] = 2.0 * Random(); break;
+        case 4: x[i] = 0.02 * Random(); break;
+      }
+    }
+    double direct = FixedPointSnr<T, size>(x, false);
+    double inverse = FixedPointSnr<T, size>(x, true);
+    (*check)(
+        direct > min_snr && inverse > min_snr,
+        "%s %d points, %s: SNR %.1f dB (inverse %.1f dB)",
+        name, static_cast<int>(size), labels[signal], direct, inverse);
+  }
+}
+
+int main(void) {
+  CheckList check;
+  srand(42);
+  TestBatch<8, 2>(&check);
+  TestBatch<64, 3>(&check);
+  TestBatch<256, 4>(&check);
+  TestBatch<1024, 8>(&check);
+  TestBatch<4096, 4>(&check);
+  TestBitReversedIncrement(&check);
+  TestAgainstDft<8>(&check);
+  TestAgainstDft<256>(&check);
+  TestAgainstDft<512>(&check);
+  TestAgainstDft<4096>(&check);
+#ifndef SHY_FFT_CONSTANT_TABLES
+  // Too slow to compile with constant tables.
+  TestAgainstDft<65536>(&check);
+  TestAgainstDft<131072>(&check);
+#endif  // SHY_FFT_CONSTANT_TABLES
+  TestFixedPoint<int16_t, 8>(&check, "Q15", 60.0);
+  TestFixedPoint<int16_t, 256>(&check, "Q15", 50.0);
+  TestFixedPoint<int16_t, 4096>(&check, "Q15", 40.0);
+  TestFixedPoint<int32_t, 256>(&check, "Q31", 140.0);
+  TestFixedPoint<int32_t, 4096>(&check, "Q31", 130.0);
+  return check.exit_code();
+}
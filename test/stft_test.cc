@@ -0,0 +1,117 @@
+// Copyright 2026 Emilie Gillet.
+//
+// Author: Emilie Gillet (emilie.o.gillet@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// STFT: with an identity spectral processor, the output is the input delayed
+// by the latency, whatever the block size. A gain applied to the spectrum is
+// applied to the output.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "stmlib/fft/stft.h"
+#include "stmlib/test/check.h"
+
+using namespace stmlib;
+
+float Random() {
+  return static_cast<float>(rand()) / RAND_MAX - 0.5f;
+}
+
+struct Gain {
+  void operator()(float* spectrum) {
+    for (size_t i = 0; i < size; ++i) {
+      spectrum[i] *= gain;
+    }
+  }
+  size_t size;
+  float gain;
+};
+
+const size_t kSize = 8192;
+
+template<size_t fft_size, size_t hop>
+void TestRoundTrip(CheckList* check, size_t block_size, float gain) {
+  typedef Stft<fft_size, hop> TestStft;
+  static typename TestStft::FFT fft;
+  static float buffer[TestStft::buffer_size];
+  TestStft stft;
+  fft.Init();
+  stft.Init(&fft, buffer);
+  Gain processor = { fft_size, gain };
+
+  static float in[kSize];
+  static float out[kSize];
+  for (size_t i = 0; i < kSize; ++i) {
+    in[i] = Random();
+  }
+
+  // block_size = 0 stands for random block sizes.
+  size_t done = 0;
+  while (done < kSize) {
+    size_t size = block_size ? block_size : rand() % (2 * hop) + 1;
+    size = std::min(size, kSize - done);
+    stft.Process(&processor, &in[done], &out[done], size);
+    done += size;
+  }
+
+  // Before the first frame is complete, the output is silent. After the
+  // first fft_size samples, all the overlapping frames are accumulated.
+  const size_t latency = TestStft::latency;
+  float error = 0.0f;
+  for (size_t i = 0; i < latency; ++i) {
+    error = std::max(error, fabsf(out[i]));
+  }
+  for (size_t i = latency + fft_size; i < kSize; ++i) {
+    error = std::max(error, fabsf(out[i] - gain * in[i - latency]));
+  }
+  char blocks[32];
+  if (block_size) {
+    snprintf(
+        blocks, sizeof(blocks), "blocks of %d", static_cast<int>(block_size));
+  } else {
+    snprintf(blocks, sizeof(blocks), "random blocks");
+  }
+  (*check)(
+      error < 1e-5f,
+      "%d points, hop %d, %s, gain %g: delayed input (error %g)",
+      static_cast<int>(fft_size), static_cast<int>(hop), blocks, gain, error);
+}
+
+int main(void) {
+  CheckList check;
+  srand(42);
+  const size_t block_sizes[] = { 0, 1, 7, 32, 64, 100, 256, 1000 };
+  for (size_t i = 0; i < sizeof(block_sizes) / sizeof(size_t); ++i) {
+    TestRoundTrip<256, 64>(&check, block_sizes[i], 1.0f);
+    TestRoundTrip<256, 128>(&check, block_sizes[i], 1.0f);
+    TestRoundTrip<1024, 256>(&check, block_sizes[i], 1.0f);
+  }
+  TestRoundTrip<512, 128>(&check, 0, 0.5f);
+  TestRoundTrip<512, 128>(&check, 0, 0.0f);
+  return check.exit_code();
+}